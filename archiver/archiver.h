@@ -1,49 +1,40 @@
 #pragma once
+#include <cstddef>
+#include <span>
+#include <string>
 #include <vector>
-#include <array>
-#include <memory>
 
+#include "archiver/basic_archiver.h"
 #include "reader/reader_interface.h"
 #include "writer/writer_interface.h"
-#include "binary_trie/binary_trie.h"
 
-class Archiver {
-public:
-    void Compress(std::vector<std::unique_ptr<ReaderInterface>>&& readers, std::unique_ptr<WriterInterface> writer,
-                  const std::string& output_file_name);
-    void Decompress(std::unique_ptr<ReaderInterface> reader, std::unique_ptr<WriterInterface> writer);
-
-private:
-    static const size_t kMaxAlphabetSize = 259;
-    static const size_t kMaxHuffmanCodeBits = 9;
+class BufferWriter;
 
-    enum class SpecialCodes { kFileNameEnd = 256, kOneMoreFile = 257, kArchiveEnd = 258 };
+// A file kept in memory by the caller, the archiver reads and returns such files without copying them.
+struct MemoryFile {
+    std::string name;
+    std::span<const std::byte> data;
+};
 
-    struct HuffmanCode {
-        int16_t code = 0;
-        char length = 0;
-    };
+extern template class BasicArchiver<ReaderInterface, WriterInterface>;
 
-    struct SymbolWithCode {
-        int16_t symbol = 0;
-        HuffmanCode huffman;
-    };
-
-    using FrequenciesArray = std::array<size_t, kMaxAlphabetSize>;
-    using HuffmanCodesArray = std::array<HuffmanCode, kMaxAlphabetSize>;
+// Archiver working with any readers and writers through their interfaces, and with files in memory.
+class Archiver : public BasicArchiver<ReaderInterface, WriterInterface> {
+public:
+    using BasicArchiver::Compress;
+    using BasicArchiver::Decompress;
+
+    // Appends the archive of files to archive, growing it as needed.
+    void Compress(std::span<const MemoryFile> files, std::vector<std::byte>& archive);
+    // Writes the archive of files to the start of archive and returns this part of it. Throws std::length_error
+    // if the archive doesn't fit.
+    std::span<std::byte> Compress(std::span<const MemoryFile> files, std::span<std::byte> archive);
+    // Appends the decompressed files to output one after another, the returned files view their parts of it.
+    std::vector<MemoryFile> Decompress(std::span<const std::byte> archive, std::vector<std::byte>& output);
+    // Same, but writes the files to the start of output and throws std::length_error if they don't fit.
+    std::vector<MemoryFile> Decompress(std::span<const std::byte> archive, std::span<std::byte> output);
 
 private:
-    void AddCompressedFile(std::unique_ptr<ReaderInterface>& reader, std::unique_ptr<WriterInterface>& writer,
-                           bool is_last);
-    FrequenciesArray CountFrequencies(std::unique_ptr<ReaderInterface>& reader);
-    HuffmanCodesArray BuildHuffmanCodes(const FrequenciesArray& frequencies);
-    std::vector<SymbolWithCode> ToCanonical(HuffmanCodesArray& huffman_codes);
-    void WriteHuffmanCode(std::unique_ptr<WriterInterface>& writer, HuffmanCode code);
-    bool DecompressFile(std::unique_ptr<ReaderInterface>& reader, std::unique_ptr<WriterInterface>& writer,
-                        const BinaryTrie<int16_t>& trie);
-    BinaryTrie<int16_t> RestoreBinaryTrie(std::unique_ptr<ReaderInterface>& reader);
-    int16_t ReadMaxHuffmanCodeBits(std::unique_ptr<ReaderInterface>& reader);
-    int16_t ReadCodeWithTrie(std::unique_ptr<ReaderInterface>& reader, const BinaryTrie<int16_t>& trie);
-    HuffmanCode ToHuffmanCode(const BinaryTrie<int16_t>::BinaryPath& binary_path);
-    BinaryTrie<int16_t>::BinaryPath ToBinaryPath(const HuffmanCode& huffman_code);
-};
\ No newline at end of file
+    void CompressFromMemory(std::span<const MemoryFile> files, BufferWriter& writer);
+    std::vector<MemoryFile> DecompressToMemory(std::span<const std::byte> archive, BufferWriter& writer);
+};
@@ -0,0 +1,603 @@
+#include "archiver_base.h"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "archiver/byte_histogram.h"
+#include "writer/memory_writer.h"
+
+void ArchiverBase::SetDecodeEngine(DecodeEngine engine) {
+    decode_engine_ = engine;
+}
+
+void ArchiverBase::SetThreadsCount(size_t threads_count) {
+    threads_count_ = std::max(threads_count, size_t(1));
+}
+
+void ArchiverBase::SetChunkSize(size_t chunk_size) {
+    chunk_size_ = std::clamp(chunk_size, size_t(1), (size_t(1) << kChunkSizeBits) - 1);
+}
+
+void ArchiverBase::SetMaxCodeLength(size_t max_code_length) {
+    max_code_length_ = std::clamp(max_code_length, size_t(kMinMaxCodeLength), size_t(HuffmanDecoder::kMaxCodeLength));
+}
+
+void ArchiverBase::SetChunkLayout(ChunkLayout layout) {
+    chunk_layout_ = layout;
+}
+
+ArchiverBase::FrequenciesArray ArchiverBase::CountFrequencies(std::span<const unsigned char> data,
+                                                      const std::string* file_name) {
+    FrequenciesArray frequencies{};
+
+    CountBytes(data, std::span(frequencies).first<kByteValues>());
+
+    frequencies[size_t(SpecialCodes::kFileNameEnd)] = 1;
+    frequencies[size_t(SpecialCodes::kOneMoreFile)] = 1;
+    frequencies[size_t(SpecialCodes::kArchiveEnd)] = 1;
+    frequencies[size_t(SpecialCodes::kOneMoreChunk)] = 1;
+
+    if (file_name != nullptr) {
+        for (char c : *file_name) {
+            ++frequencies[*reinterpret_cast<unsigned char*>(&c)];
+        }
+    }
+
+    return frequencies;
+}
+
+void ArchiverBase::EncodeChunk(std::span<const unsigned char> data, const std::string* file_name, SpecialCodes next_chunk,
+                           MemoryWriter& writer) {
+    // Already compressed data doesn't shrink, so such a chunk is stored as is with a table for the rest only.
+    FrequenciesArray stored_frequencies = CountFrequencies({}, file_name);
+    HuffmanCodesArray stored_huffman_codes = BuildHuffmanCodes(stored_frequencies);
+    HuffmanCodesArray huffman_codes = stored_huffman_codes;
+    ChunkLayout layout = ChunkLayout::kStored;
+
+    // A few sampled windows are enough to recognize such data, so it is not counted in full.
+    if (data.size() < kEntropyProbeMinSize ||
+        EstimateEntropy(data, kEntropyProbeWindowSize, kEntropyProbeWindows) < kIncompressibleEntropy) {
+        FrequenciesArray frequencies = CountFrequencies(data, file_name);
+
+        huffman_codes = BuildHuffmanCodes(frequencies);
+        layout = chunk_layout_;
+
+        if (EstimateEncodedBits(stored_frequencies, stored_huffman_codes) + (data.size() + 1) * CHAR_BIT <=
+            EstimateEncodedBits(frequencies, huffman_codes)) {
+            huffman_codes = stored_huffman_codes;
+            layout = ChunkLayout::kStored;
+        }
+    }
+
+    writer.WriteBits(uint64_t(layout), kChunkLayoutBits);
+    ToCanonical(huffman_codes);
+    WriteHuffmanTable(writer, huffman_codes);
+
+    if (file_name != nullptr) {
+        for (char c : *file_name) {
+            WriteHuffmanCode(writer, huffman_codes[*reinterpret_cast<unsigned char*>(&c)]);
+        }
+
+        WriteHuffmanCode(writer, huffman_codes[size_t(SpecialCodes::kFileNameEnd)]);
+    }
+
+    WriteHuffmanCode(writer, huffman_codes[size_t(next_chunk)]);
+
+    if (layout == ChunkLayout::kStored) {
+        writer.Flush();
+        writer.WriteBytes(data);
+        return;
+    }
+
+    if (layout == ChunkLayout::kInterleaved) {
+        EncodeInterleaved(data, huffman_codes, writer);
+        return;
+    }
+
+    for (unsigned char byte : data) {
+        WriteHuffmanCode(writer, huffman_codes[byte]);
+    }
+
+    writer.Flush();
+}
+
+size_t ArchiverBase::EstimateEncodedBits(const FrequenciesArray& frequencies, const HuffmanCodesArray& huffman_codes) {
+    size_t encoded_bits = GetHuffmanTableBits(huffman_codes);
+
+    for (size_t i = 0; i < kMaxAlphabetSize; ++i) {
+        encoded_bits += frequencies[i] * huffman_codes[i].length;
+    }
+
+    return encoded_bits;
+}
+
+void ArchiverBase::EncodeInterleaved(std::span<const unsigned char> data, const HuffmanCodesArray& huffman_codes,
+                                 MemoryWriter& writer) {
+    std::array<MemoryWriter, HuffmanDecoder::kInterleavedStreams> streams;
+    size_t stream_size = (data.size() + streams.size() - 1) / streams.size();
+
+    for (MemoryWriter& stream : streams) {
+        size_t size = std::min(stream_size, data.size());
+
+        for (unsigned char byte : data.first(size)) {
+            WriteHuffmanCode(stream, huffman_codes[byte]);
+        }
+
+        stream.Flush();
+        data = data.subspan(size);
+    }
+
+    writer.Flush();
+
+    for (MemoryWriter& stream : streams) {
+        writer.WriteBits(stream.GetData().size(), kChunkSizeBits);
+    }
+
+    for (MemoryWriter& stream : streams) {
+        stream.MoveTo(writer);
+    }
+}
+
+ArchiverBase::HuffmanCodesArray ArchiverBase::BuildHuffmanCodes(const FrequenciesArray& frequencies) {
+    // Two-queue construction: leaves sorted by frequency and merged nodes in creation order are both
+    // sorted, since every merged node weighs no less than the previous one, so the two lightest nodes are
+    // always at the fronts of the queues.
+    struct QueueNode {
+        bool operator<(const QueueNode& o) const {
+            return std::tie(priority, val) < std::tie(o.priority, o.val);
+        }
+
+        size_t priority;
+        size_t trie_index;
+        size_t val;
+    };
+
+    std::pmr::monotonic_buffer_resource arena(kHuffmanArenaSize);
+    std::pmr::vector<HuffmanTrie> tries(&arena);
+    std::pmr::vector<QueueNode> leaves(&arena);
+    std::pmr::vector<QueueNode> merged(&arena);
+
+    tries.reserve(kMaxAlphabetSize);
+    leaves.reserve(kMaxAlphabetSize);
+
+    for (size_t i = 0; i < kMaxAlphabetSize; ++i) {
+        if (frequencies[i]) {
+            leaves.push_back({.priority = frequencies[i], .trie_index = tries.size(), .val = i});
+            tries.emplace_back(i, &arena);
+        }
+    }
+
+    std::sort(leaves.begin(), leaves.end());
+    merged.reserve(leaves.size());
+
+    size_t next_leaf = 0;
+    size_t next_merged = 0;
+
+    auto pop_lightest = [&]() {
+        if (next_merged == merged.size() || (next_leaf < leaves.size() && leaves[next_leaf] < merged[next_merged])) {
+            return leaves[next_leaf++];
+        }
+
+        return merged[next_merged++];
+    };
+
+    while ((leaves.size() - next_leaf) + (merged.size() - next_merged) > 1) {
+        auto [prior1, idx1, val1] = pop_lightest();
+        auto [prior2, idx2, val2] = pop_lightest();
+
+        tries[idx1].Merge(std::move(tries[idx2]));
+        merged.push_back({.priority = prior1 + prior2, .trie_index = idx1, .val = std::min(val1, val2)});
+    }
+
+    size_t final_idx = merged.empty() ? leaves.front().trie_index : merged.back().trie_index;
+    HuffmanTrie trie(std::move(tries[final_idx]));
+
+    std::array<HuffmanCode, kMaxAlphabetSize> huffman_codes;
+    size_t max_length = 0;
+
+    for (auto iter = trie.begin(); iter != trie.end(); ++iter) {
+        auto path = iter.GetPath();
+
+        huffman_codes[*iter] = ToHuffmanCode(path);
+        max_length = std::max(max_length, size_t(path.length));
+    }
+
+    // Codes are made canonical later, so only their lengths matter here.
+    if (max_length > max_code_length_) {
+        std::array<size_t, kMaxAlphabetSize> lengths = LimitCodeLengths(frequencies, max_code_length_);
+
+        for (size_t i = 0; i < kMaxAlphabetSize; ++i) {
+            huffman_codes[i] = {.code = 0, .length = char(lengths[i])};
+        }
+    }
+
+    return huffman_codes;
+}
+
+std::array<size_t, ArchiverBase::kMaxAlphabetSize> ArchiverBase::LimitCodeLengths(const FrequenciesArray& frequencies,
+                                                                          size_t max_length) {
+    // Package-merge: a list of items is built for every length from max_length up to 1, each list is the symbols
+    // merged with pairs (packages) of the previous list. The cheapest 2 * n - 2 items of the last list
+    // give the optimal code with lengths limited by max_length, the length of a symbol being the number of
+    // times it occurs in these items.
+    struct Item {
+        size_t weight = 0;
+        int16_t symbol = HuffmanDecoder::kNoSymbol;
+        size_t first_child = 0;
+        size_t second_child = 0;
+    };
+
+    std::vector<Item> items;
+    std::vector<size_t> leaves;
+
+    for (size_t i = 0; i < kMaxAlphabetSize; ++i) {
+        if (frequencies[i] != 0) {
+            leaves.push_back(items.size());
+            items.push_back({.weight = frequencies[i], .symbol = int16_t(i)});
+        }
+    }
+
+    std::stable_sort(leaves.begin(), leaves.end(),
+                     [&items](size_t a, size_t b) { return items[a].weight < items[b].weight; });
+
+    std::vector<size_t> list;
+
+    for (size_t length = 0; length < max_length; ++length) {
+        std::vector<size_t> packages;
+
+        for (size_t i = 0; i + 1 < list.size(); i += 2) {
+            packages.push_back(items.size());
+            items.push_back({.weight = items[list[i]].weight + items[list[i + 1]].weight,
+                             .first_child = list[i],
+                             .second_child = list[i + 1]});
+        }
+
+        list.clear();
+        std::merge(leaves.begin(), leaves.end(), packages.begin(), packages.end(), std::back_inserter(list),
+                   [&items](size_t a, size_t b) { return items[a].weight < items[b].weight; });
+    }
+
+    std::array<size_t, kMaxAlphabetSize> lengths{};
+    std::vector<size_t> stack(list.begin(), list.begin() + std::min(list.size(), 2 * leaves.size() - 2));
+
+    while (!stack.empty()) {
+        const Item& item = items[stack.back()];
+
+        stack.pop_back();
+
+        if (item.symbol != HuffmanDecoder::kNoSymbol) {
+            ++lengths[item.symbol];
+        } else {
+            stack.push_back(item.first_child);
+            stack.push_back(item.second_child);
+        }
+    }
+
+    return lengths;
+}
+
+void ArchiverBase::ToCanonical(HuffmanCodesArray& huffman_codes) {
+    std::vector<int16_t> codes_order;
+
+    for (size_t i = 0; i < kMaxAlphabetSize; ++i)
+        if (huffman_codes[i].length != 0) {
+            codes_order.push_back(i);
+        }
+
+    std::sort(codes_order.begin(), codes_order.end(), [&huffman_codes](int16_t a, int16_t b) {
+        return std::tie(huffman_codes[a].length, a) < std::tie(huffman_codes[b].length, b);
+    });
+
+    if (!codes_order.empty()) {
+        huffman_codes[codes_order[0]].code = 0;
+    }
+
+    for (size_t i = 1; i < codes_order.size(); ++i) {
+        char length = huffman_codes[codes_order[i]].length;
+        char previous_length = huffman_codes[codes_order[i - 1]].length;
+
+        huffman_codes[codes_order[i]].code = huffman_codes[codes_order[i - 1]].code + 1;
+
+        if (length > previous_length) {
+            huffman_codes[codes_order[i]].code <<= (length - previous_length);
+        }
+    }
+}
+
+std::vector<ArchiverBase::CodeLengthToken> ArchiverBase::ToCodeLengthTokens(const HuffmanCodesArray& huffman_codes) {
+    std::vector<CodeLengthToken> tokens;
+    size_t symbols_count = kMaxAlphabetSize;
+
+    while (symbols_count > 0 && huffman_codes[symbols_count - 1].length == 0) {
+        --symbols_count;
+    }
+
+    for (size_t i = 0; i < symbols_count;) {
+        uint8_t length = huffman_codes[i].length;
+        size_t run = 1;
+
+        while (i + run < symbols_count && huffman_codes[i + run].length == length) {
+            ++run;
+        }
+
+        i += run;
+
+        // A run of non-zero lengths repeats the length written just before it.
+        if (length != 0) {
+            tokens.push_back({.symbol = length});
+            --run;
+        }
+
+        while (run >= kMinRepeatCount) {
+            CodeLengthCodes code = CodeLengthCodes::kRepeatPrevious;
+
+            if (length == 0) {
+                code = (run >= kMinLongRepeatCount ? CodeLengthCodes::kRepeatZeroLong : CodeLengthCodes::kRepeatZero);
+            }
+
+            size_t count = std::min(run, GetMinRepeatCount(code) + (size_t(1) << GetRepeatCountBits(code)) - 1);
+
+            tokens.push_back({.symbol = uint8_t(code), .repeat_count = uint8_t(count)});
+            run -= count;
+        }
+
+        tokens.insert(tokens.end(), run, {.symbol = length});
+    }
+
+    return tokens;
+}
+
+ArchiverBase::HuffmanCodesArray ArchiverBase::BuildCodeLengthCodes(const std::vector<CodeLengthToken>& tokens) {
+    FrequenciesArray frequencies{};
+    HuffmanCodesArray code_length_codes{};
+    size_t used_symbols = 0;
+
+    for (CodeLengthToken token : tokens) {
+        used_symbols += (frequencies[token.symbol]++ == 0);
+    }
+
+    // A single symbol still needs a code of one bit.
+    if (used_symbols == 1) {
+        code_length_codes[tokens.front().symbol].length = 1;
+    } else {
+        std::array<size_t, kMaxAlphabetSize> lengths = LimitCodeLengths(frequencies, kMaxCodeLengthCodeLength);
+
+        for (size_t i = 0; i < kCodeLengthAlphabetSize; ++i) {
+            code_length_codes[i].length = char(lengths[i]);
+        }
+    }
+
+    ToCanonical(code_length_codes);
+
+    return code_length_codes;
+}
+
+size_t ArchiverBase::GetCodeLengthCodesCount(const HuffmanCodesArray& code_length_codes) {
+    size_t count = kCodeLengthAlphabetSize;
+
+    while (count > kMinCodeLengthCodesCount && code_length_codes[kCodeLengthOrder[count - 1]].length == 0) {
+        --count;
+    }
+
+    return count;
+}
+
+size_t ArchiverBase::GetMinRepeatCount(CodeLengthCodes code) {
+    return (code == CodeLengthCodes::kRepeatZeroLong ? kMinLongRepeatCount : kMinRepeatCount);
+}
+
+size_t ArchiverBase::GetRepeatCountBits(CodeLengthCodes code) {
+    return kRepeatCountBits[size_t(code) - size_t(CodeLengthCodes::kRepeatPrevious)];
+}
+
+size_t ArchiverBase::GetHuffmanTableBits(const HuffmanCodesArray& huffman_codes) {
+    std::vector<CodeLengthToken> tokens = ToCodeLengthTokens(huffman_codes);
+    HuffmanCodesArray code_length_codes = BuildCodeLengthCodes(tokens);
+    size_t bits = kCodeLengthCodesCountBits + GetCodeLengthCodesCount(code_length_codes) * kCodeLengthCodeLengthBits +
+                  kMaxHuffmanCodeBits;
+
+    for (CodeLengthToken token : tokens) {
+        bits += code_length_codes[token.symbol].length;
+
+        if (token.symbol >= size_t(CodeLengthCodes::kRepeatPrevious)) {
+            bits += GetRepeatCountBits(CodeLengthCodes(token.symbol));
+        }
+    }
+
+    return bits;
+}
+
+void ArchiverBase::WriteHuffmanTable(MemoryWriter& writer, const HuffmanCodesArray& huffman_codes) {
+    std::vector<CodeLengthToken> tokens = ToCodeLengthTokens(huffman_codes);
+    HuffmanCodesArray code_length_codes = BuildCodeLengthCodes(tokens);
+    size_t code_length_codes_count = GetCodeLengthCodesCount(code_length_codes);
+    size_t symbols_count = 0;
+
+    writer.WriteBits(code_length_codes_count - kMinCodeLengthCodesCount, kCodeLengthCodesCountBits);
+
+    for (size_t i = 0; i < code_length_codes_count; ++i) {
+        writer.WriteBits(code_length_codes[kCodeLengthOrder[i]].length, kCodeLengthCodeLengthBits);
+    }
+
+    for (CodeLengthToken token : tokens) {
+        symbols_count += (token.symbol >= size_t(CodeLengthCodes::kRepeatPrevious) ? token.repeat_count : 1);
+    }
+
+    writer.WriteBits(symbols_count, kMaxHuffmanCodeBits);
+
+    for (CodeLengthToken token : tokens) {
+        WriteHuffmanCode(writer, code_length_codes[token.symbol]);
+
+        if (token.symbol >= size_t(CodeLengthCodes::kRepeatPrevious)) {
+            CodeLengthCodes code = CodeLengthCodes(token.symbol);
+
+            writer.WriteBits(token.repeat_count - GetMinRepeatCount(code), GetRepeatCountBits(code));
+        }
+    }
+}
+
+void ArchiverBase::WriteHuffmanCode(MemoryWriter& writer, HuffmanCode code) {
+    writer.WriteBits(code.code, code.length);
+}
+
+std::string ArchiverBase::ReadFileName(BitReader& reader, const HuffmanDecoder& decoder) {
+    std::string file_name;
+
+    while (true) {
+        int16_t symbol = decoder.Decode(reader);
+
+        if (symbol == int16_t(SpecialCodes::kFileNameEnd)) {
+            break;
+        }
+
+        if (symbol > UCHAR_MAX) {
+            throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+        }
+
+        unsigned char char_symbol = symbol;
+        file_name.push_back(*reinterpret_cast<char*>(&char_symbol));
+    }
+
+    return file_name;
+}
+
+void ArchiverBase::DecodeChunkData(BitReader& reader, const HuffmanDecoder& decoder, ChunkLayout layout,
+                               std::span<const unsigned char> body, std::span<unsigned char> data) {
+    if (layout == ChunkLayout::kStored) {
+        // Stored bytes are the last bytes of the body.
+        if (data.size() > body.size()) {
+            throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+        }
+
+        std::copy(body.end() - data.size(), body.end(), data.begin());
+        return;
+    }
+
+    if (layout == ChunkLayout::kInterleaved) {
+        std::array<std::span<const unsigned char>, HuffmanDecoder::kInterleavedStreams> streams;
+        std::array<std::span<unsigned char>, HuffmanDecoder::kInterleavedStreams> outputs;
+        std::array<size_t, HuffmanDecoder::kInterleavedStreams> stream_sizes;
+        size_t streams_size = 0;
+        size_t stream_data_size = (data.size() + streams.size() - 1) / streams.size();
+
+        reader.AlignToByte();
+
+        for (size_t i = 0; i < streams.size(); ++i) {
+            if (!reader.HasBits(kChunkSizeBits)) {
+                throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+            }
+
+            stream_sizes[i] = reader.ReadBits(kChunkSizeBits);
+            streams_size += stream_sizes[i];
+            outputs[i] = data.subspan(std::min(i * stream_data_size, data.size()));
+            outputs[i] = outputs[i].first(std::min(stream_data_size, outputs[i].size()));
+        }
+
+        if (streams_size > body.size()) {
+            throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+        }
+
+        // Streams are the last bytes of the body.
+        body = body.last(streams_size);
+
+        for (size_t i = 0; i < streams.size(); ++i) {
+            streams[i] = body.first(stream_sizes[i]);
+            body = body.subspan(stream_sizes[i]);
+        }
+
+        std::array<BitReader, HuffmanDecoder::kInterleavedStreams> stream_readers = {
+            BitReader(streams[0]), BitReader(streams[1]), BitReader(streams[2]), BitReader(streams[3])};
+
+        decoder.DecodeInterleaved(stream_readers, outputs);
+        return;
+    }
+
+    int16_t stop_symbol = HuffmanDecoder::kNoSymbol;
+
+    if (decoder.DecodeBytes(reader, data, stop_symbol) != data.size() || stop_symbol != HuffmanDecoder::kNoSymbol) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+}
+
+HuffmanDecoder ArchiverBase::RestoreHuffmanDecoder(BitReader& reader) {
+    std::array<uint8_t, kCodeLengthAlphabetSize> code_length_lengths{};
+    size_t code_length_codes_count = ReadTableBits(reader, kCodeLengthCodesCountBits) + kMinCodeLengthCodesCount;
+
+    if (code_length_codes_count > kCodeLengthAlphabetSize) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    for (size_t i = 0; i < code_length_codes_count; ++i) {
+        code_length_lengths[kCodeLengthOrder[i]] = ReadTableBits(reader, kCodeLengthCodeLengthBits);
+    }
+
+    HuffmanDecoder code_length_decoder = ToHuffmanDecoder(code_length_lengths, DecodeEngine::kSingleSymbol);
+    std::array<uint8_t, kMaxAlphabetSize> lengths{};
+    size_t symbols_count = ReadTableBits(reader, kMaxHuffmanCodeBits);
+
+    if (symbols_count > kMaxAlphabetSize) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    for (size_t i = 0; i < symbols_count;) {
+        int16_t symbol = code_length_decoder.Decode(reader);
+
+        if (symbol < int16_t(CodeLengthCodes::kRepeatPrevious)) {
+            lengths[i++] = symbol;
+            continue;
+        }
+
+        CodeLengthCodes code = CodeLengthCodes(symbol);
+        size_t count = ReadTableBits(reader, GetRepeatCountBits(code)) + GetMinRepeatCount(code);
+
+        if ((code == CodeLengthCodes::kRepeatPrevious && i == 0) || count > symbols_count - i) {
+            throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+        }
+
+        std::fill_n(lengths.begin() + i, count, (code == CodeLengthCodes::kRepeatPrevious ? lengths[i - 1] : 0));
+        i += count;
+    }
+
+    return ToHuffmanDecoder(lengths, decode_engine_);
+}
+
+HuffmanDecoder ArchiverBase::ToHuffmanDecoder(std::span<const uint8_t> lengths, DecodeEngine engine) {
+    std::vector<int16_t> symbols;
+    std::vector<int16_t> length_counts(*std::max_element(lengths.begin(), lengths.end()));
+
+    // Canonical codes go in the order of length and then of symbol.
+    for (size_t length = 1; length <= length_counts.size(); ++length) {
+        for (size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+            if (lengths[symbol] == length) {
+                symbols.push_back(symbol);
+                ++length_counts[length - 1];
+            }
+        }
+    }
+
+    return HuffmanDecoder(symbols, length_counts, engine);
+}
+
+uint64_t ArchiverBase::ReadTableBits(BitReader& reader, size_t count) {
+    if (!reader.HasBits(count)) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    return reader.ReadBits(count);
+}
+
+ArchiverBase::HuffmanCode ArchiverBase::ToHuffmanCode(const HuffmanTrie::BinaryPath& binary_path) {
+    HuffmanCode huffman{.length = char(binary_path.length)};
+
+    for (char i = 0; i < huffman.length; ++i) {
+        if ((binary_path.code >> i) & 1) {
+            huffman.code |= (uint64_t(1) << (huffman.length - 1 - i));
+        }
+    }
+
+    return huffman;
+}
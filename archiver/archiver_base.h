@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "binary_trie/binary_trie.h"
+#include "reader/bit_reader.h"
+#include "archiver/huffman_decoder.h"
+
+class MemoryWriter;
+
+// kSingleStream encodes chunk bytes as one bitstream. kInterleaved splits them into
+// HuffmanDecoder::kInterleavedStreams equal parts with separate bitstreams, which are decoded side by side.
+// kStored keeps the bytes as they are, it is chosen instead of the other layouts for chunks that don't shrink.
+enum class ChunkLayout { kSingleStream = 0, kInterleaved = 1, kStored = 2 };
+
+// Archive is a sequence of chunks, every file is split into one or more chunks of at most chunk size bytes.
+// Chunk layout: original size (32 bits), compressed size (32 bits) and compressed body padded to a whole byte.
+// Body is ChunkLayout (8 bits), Huffman table, file name ending with kFileNameEnd (only in the first chunk of
+// a file), one of kOneMoreChunk, kOneMoreFile or kArchiveEnd telling what follows this chunk, and the encoded
+// chunk bytes. With kInterleaved the bytes start at a byte boundary with the sizes of all streams (32 bits each)
+// followed by the streams, each padded to a whole byte. With kStored the bytes follow as is from a byte boundary.
+// The Huffman table is stored like in DEFLATE: the count of code length codes minus kMinCodeLengthCodesCount
+// (4 bits), their lengths in kCodeLengthOrder (3 bits each), the count of symbols up to the last one with a code
+// (9 bits) and the code lengths of these symbols in CodeLengthCodes, with the repeat count (2, 3 or 7 bits)
+// after every repeat code. Codes are canonical, so their lengths are enough to restore them.
+// The chunks are followed by a directory with name, offset, original and compressed size of every file,
+// and the archive ends with the directory offset (64 bits) and kDirectoryMagic (32 bits).
+// ArchiverBase holds the settings and codes chunks in memory, BasicArchiver moves archives and files through its
+// readers and writers.
+class ArchiverBase {
+public:
+    static const size_t kDefaultChunkSize = 4 << 20;
+    static const size_t kMinMaxCodeLength = 9;
+
+    void SetDecodeEngine(DecodeEngine engine);
+    void SetThreadsCount(size_t threads_count);
+    void SetChunkSize(size_t chunk_size);
+    void SetChunkLayout(ChunkLayout layout);
+    // Limits the length of Huffman codes. The limit is clamped to [kMinMaxCodeLength, HuffmanDecoder::kMaxCodeLength],
+    // kMinMaxCodeLength bits being enough to give a code to every symbol of the alphabet.
+    void SetMaxCodeLength(size_t max_code_length);
+
+protected:
+    static const size_t kMaxAlphabetSize = 260;
+    static const size_t kMaxHuffmanCodeBits = 9;
+    static const size_t kChunkSizeBits = 32;
+    static const size_t kChunkLayoutBits = 8;
+    static const size_t kFilesInFlightPerThread = 2;
+    static constexpr size_t kChunksInFlightPerThread = 2;
+    static const size_t kPipelineDepth = 2;
+    static const size_t kNumberBits = 64;
+    static const size_t kFileNameLengthBits = 32;
+    static const size_t kDirectoryMagicBits = 32;
+    static const size_t kHuffmanArenaSize = 64 << 10;
+    static const size_t kEntropyProbeWindowSize = 1 << 10;
+    static const size_t kEntropyProbeWindows = 16;
+    static const size_t kEntropyProbeMinSize = 64 << 10;
+    // Huffman coding saves at most 8 - entropy bits per byte, which is not worth counting the chunk for.
+    static constexpr double kIncompressibleEntropy = 7.95;
+    static const uint32_t kDirectoryMagic = 0x48554644;
+    static const size_t kCodeLengthAlphabetSize = 19;
+    static const size_t kMaxCodeLengthCodeLength = 7;
+    static const size_t kCodeLengthCodeLengthBits = 3;
+    static const size_t kCodeLengthCodesCountBits = 4;
+    static const size_t kMinCodeLengthCodesCount = 4;
+    static const size_t kMinRepeatCount = 3;
+    static const size_t kMinLongRepeatCount = 11;
+    // Bits of the repeat count after kRepeatPrevious, kRepeatZero and kRepeatZeroLong.
+    static constexpr std::array<uint8_t, 3> kRepeatCountBits = {2, 3, 7};
+    // Lengths of the code length codes are written in this order, so the rarely used ones at the end are omitted.
+    static constexpr std::array<uint8_t, kCodeLengthAlphabetSize> kCodeLengthOrder = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    enum class SpecialCodes { kFileNameEnd = 256, kOneMoreFile = 257, kArchiveEnd = 258, kOneMoreChunk = 259 };
+    // Code length alphabet: 0-15 are code lengths, the rest repeat the previous length or zero several times.
+    enum class CodeLengthCodes { kRepeatPrevious = 16, kRepeatZero = 17, kRepeatZeroLong = 18 };
+
+    struct HuffmanCode {
+        uint64_t code = 0;
+        char length = 0;
+    };
+
+    struct CodeLengthToken {
+        uint8_t symbol = 0;
+        uint8_t repeat_count = 0;
+    };
+
+    struct MemberInfo {
+        std::string file_name;
+        uint64_t offset = 0;
+        uint64_t original_size = 0;
+        uint64_t compressed_size = 0;
+    };
+
+    using FrequenciesArray = std::array<size_t, kMaxAlphabetSize>;
+    using HuffmanCodesArray = std::array<HuffmanCode, kMaxAlphabetSize>;
+    // Tries of one code build take their nodes from one arena, which is dropped at once when the codes are ready.
+    using HuffmanTrie = BinaryTrie<int16_t, std::pmr::polymorphic_allocator<int16_t>>;
+
+protected:
+    FrequenciesArray CountFrequencies(std::span<const unsigned char> data, const std::string* file_name);
+    void EncodeChunk(std::span<const unsigned char> data, const std::string* file_name, SpecialCodes next_chunk,
+                     MemoryWriter& writer);
+    HuffmanCodesArray BuildHuffmanCodes(const FrequenciesArray& frequencies);
+    // Size of the Huffman table and of all the symbols counted in frequencies encoded with huffman_codes.
+    size_t EstimateEncodedBits(const FrequenciesArray& frequencies, const HuffmanCodesArray& huffman_codes);
+    std::array<size_t, kMaxAlphabetSize> LimitCodeLengths(const FrequenciesArray& frequencies, size_t max_length);
+    void ToCanonical(HuffmanCodesArray& huffman_codes);
+    std::vector<CodeLengthToken> ToCodeLengthTokens(const HuffmanCodesArray& huffman_codes);
+    HuffmanCodesArray BuildCodeLengthCodes(const std::vector<CodeLengthToken>& tokens);
+    size_t GetCodeLengthCodesCount(const HuffmanCodesArray& code_length_codes);
+    size_t GetMinRepeatCount(CodeLengthCodes code);
+    size_t GetRepeatCountBits(CodeLengthCodes code);
+    size_t GetHuffmanTableBits(const HuffmanCodesArray& huffman_codes);
+    void WriteHuffmanTable(MemoryWriter& writer, const HuffmanCodesArray& huffman_codes);
+    void WriteHuffmanCode(MemoryWriter& writer, HuffmanCode code);
+    void EncodeInterleaved(std::span<const unsigned char> data, const HuffmanCodesArray& huffman_codes,
+                           MemoryWriter& writer);
+    std::string ReadFileName(BitReader& reader, const HuffmanDecoder& decoder);
+    void DecodeChunkData(BitReader& reader, const HuffmanDecoder& decoder, ChunkLayout layout,
+                         std::span<const unsigned char> body, std::span<unsigned char> data);
+    HuffmanDecoder RestoreHuffmanDecoder(BitReader& reader);
+    HuffmanDecoder ToHuffmanDecoder(std::span<const uint8_t> lengths, DecodeEngine engine);
+    uint64_t ReadTableBits(BitReader& reader, size_t count);
+    HuffmanCode ToHuffmanCode(const HuffmanTrie::BinaryPath& binary_path);
+
+protected:
+    DecodeEngine decode_engine_ = DecodeEngine::kMultiSymbol;
+    size_t threads_count_ = 1;
+    size_t chunk_size_ = kDefaultChunkSize;
+    ChunkLayout chunk_layout_ = ChunkLayout::kSingleStream;
+    size_t max_code_length_ = HuffmanDecoder::kMaxCodeLength;
+};
@@ -0,0 +1,646 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "archiver/archiver_base.h"
+#include "utility/spsc_ring/spsc_ring.h"
+#include "utility/thread_pool/thread_pool.h"
+#include "writer/memory_writer.h"
+
+// Archiver reading files and archives with Reader and writing them with Writer. With concrete final classes,
+// such as MmapReader and FileWriter, their calls are resolved at compile time. Reader must derive from
+// ReaderInterface and Writer from WriterInterface, Archiver is BasicArchiver of these interfaces.
+template <class Reader, class Writer>
+class BasicArchiver : public ArchiverBase {
+public:
+    void Compress(std::vector<std::unique_ptr<Reader>>&& readers, std::unique_ptr<Writer> writer,
+                  const std::string& output_file_name);
+    void Decompress(std::unique_ptr<Reader> reader, std::unique_ptr<Writer> writer);
+    // Decompresses files on threads count workers, each of them reads the archive with its own reader made by
+    // open_archive and writes files with its own writer made by create_writer. Needs the archive directory.
+    void DecompressInParallel(const std::function<std::unique_ptr<Reader>()>& open_archive,
+                              const std::function<std::unique_ptr<Writer>()>& create_writer);
+    // Decompresses only file file_name, reading nothing but the directory and this file's chunks.
+    void Extract(std::unique_ptr<Reader> reader, std::unique_ptr<Writer> writer, const std::string& file_name);
+
+protected:
+    void CompressMembers(std::vector<std::unique_ptr<Reader>>& readers, Writer& writer,
+                         const std::string& output_file_name);
+    void DecompressMembers(std::unique_ptr<Reader>& reader, Writer& writer, bool single_member, ThreadPool* pool);
+
+private:
+    std::vector<MemberInfo> CompressPipelined(std::vector<std::unique_ptr<Reader>>& readers, Writer& writer);
+    std::vector<MemberInfo> CompressInParallel(std::vector<std::unique_ptr<Reader>>& readers, Writer& writer);
+    // Encodes chunks on pool if it is given, busy_files is the number of files encoded on it at the same time.
+    template <class OutputWriter>
+    MemberInfo AddCompressedFile(std::unique_ptr<Reader>& reader, OutputWriter& writer, bool is_last,
+                                 ThreadPool* pool, const std::atomic<size_t>* busy_files = nullptr);
+    // Returns the chunk of the file starting at offset, viewing the reader's memory if the file stays there and
+    // reading the chunk into buffer otherwise. Sets is_last_chunk if the file ends with the chunk.
+    std::span<const unsigned char> TakeChunk(Reader& reader, size_t offset, std::vector<unsigned char>& buffer,
+                                             bool& is_last_chunk);
+    void WriteDirectory(Writer& writer, const std::vector<MemberInfo>& directory);
+    std::vector<MemberInfo> ReadDirectory(std::unique_ptr<Reader>& reader);
+    uint64_t ReadNumber(std::unique_ptr<Reader>& reader, size_t bits);
+    size_t ReadChunk(std::unique_ptr<Reader>& reader, std::vector<unsigned char>& body);
+};
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::Compress(std::vector<std::unique_ptr<Reader>>&& readers,
+                                             std::unique_ptr<Writer> writer, const std::string& output_file_name) {
+    CompressMembers(readers, *writer, output_file_name);
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::CompressMembers(std::vector<std::unique_ptr<Reader>>& readers, Writer& writer,
+                                                    const std::string& output_file_name) {
+    writer.OpenFile(output_file_name);
+
+    std::vector<MemberInfo> directory;
+
+    if (threads_count_ == 1) {
+        directory = CompressPipelined(readers, writer);
+    } else if (readers.size() > 1) {
+        directory = CompressInParallel(readers, writer);
+    } else {
+        ThreadPool pool(threads_count_);
+
+        for (size_t i = 0; i < readers.size(); ++i) {
+            directory.push_back(AddCompressedFile(readers[i], writer, i + 1 == readers.size(), &pool));
+        }
+    }
+
+    WriteDirectory(writer, directory);
+    writer.CloseFile();
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::Decompress(std::unique_ptr<Reader> reader, std::unique_ptr<Writer> writer) {
+    std::unique_ptr<ThreadPool> pool;
+
+    if (threads_count_ > 1) {
+        pool = std::make_unique<ThreadPool>(threads_count_);
+    }
+
+    DecompressMembers(reader, *writer, false, pool.get());
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::DecompressInParallel(
+    const std::function<std::unique_ptr<Reader>()>& open_archive,
+    const std::function<std::unique_ptr<Writer>()>& create_writer) {
+    std::unique_ptr<Reader> archive_reader = open_archive();
+    std::vector<MemberInfo> directory = ReadDirectory(archive_reader);
+    ThreadPool pool(threads_count_);
+
+    // With a single file there is nothing to split between workers, so its chunks are decoded in parallel instead.
+    if (directory.size() <= 1 || threads_count_ == 1) {
+        archive_reader->Seek(0);
+        DecompressMembers(archive_reader, *create_writer(), false, &pool);
+        return;
+    }
+
+    archive_reader.reset();
+
+    std::atomic<size_t> next_member = 0;
+    std::atomic<bool> has_failed = false;
+    std::vector<std::future<void>> results;
+
+    // Every worker takes the next file from the directory until there are none left,
+    // so a few big files don't keep the other workers waiting.
+    for (size_t i = 0; i < std::min(threads_count_, directory.size()); ++i) {
+        results.push_back(pool.Submit([&] {
+            std::unique_ptr<Reader> reader = open_archive();
+            std::unique_ptr<Writer> writer = create_writer();
+
+            try {
+                for (size_t member = next_member++; member < directory.size() && !has_failed; member = next_member++) {
+                    reader->Seek(directory[member].offset);
+                    DecompressMembers(reader, *writer, true, nullptr);
+                }
+            } catch (...) {
+                has_failed = true;
+                throw;
+            }
+        }));
+    }
+
+    for (std::future<void>& result : results) {
+        result.wait();
+    }
+
+    for (std::future<void>& result : results) {
+        result.get();
+    }
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::Extract(std::unique_ptr<Reader> reader, std::unique_ptr<Writer> writer,
+                                            const std::string& file_name) {
+    for (const MemberInfo& member : ReadDirectory(reader)) {
+        if (member.file_name == file_name) {
+            std::unique_ptr<ThreadPool> pool;
+
+            if (threads_count_ > 1) {
+                pool = std::make_unique<ThreadPool>(threads_count_);
+            }
+
+            reader->Seek(member.offset);
+            DecompressMembers(reader, *writer, true, pool.get());
+            return;
+        }
+    }
+
+    throw std::invalid_argument("ARCHIVER::EXTRACT: No such file in archive: " + file_name);
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::DecompressMembers(std::unique_ptr<Reader>& reader, Writer& writer,
+                                                      bool single_member, ThreadPool* pool) {
+    struct ChunkJob {
+        std::vector<unsigned char> body;
+        std::vector<unsigned char> data;
+        std::string file_name;
+        bool opens_file = false;
+        std::future<void> result;
+    };
+
+    std::deque<ChunkJob> jobs;
+    size_t max_jobs = (pool != nullptr ? kChunksInFlightPerThread * threads_count_ : 1);
+    bool has_open_file = false;
+    bool is_done = false;
+    SpecialCodes next_chunk = SpecialCodes::kOneMoreFile;
+
+    try {
+        while (!jobs.empty() || !is_done) {
+            if (!is_done) {
+                ChunkJob& job = jobs.emplace_back();
+
+                job.data.resize(ReadChunk(reader, job.body));
+                job.opens_file = (next_chunk != SpecialCodes::kOneMoreChunk);
+
+                BitReader bit_reader(job.body);
+
+                if (!bit_reader.HasBits(kChunkLayoutBits)) {
+                    throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+                }
+
+                ChunkLayout layout = ChunkLayout(bit_reader.ReadBits(kChunkLayoutBits));
+
+                if (layout != ChunkLayout::kSingleStream && layout != ChunkLayout::kInterleaved &&
+                    layout != ChunkLayout::kStored) {
+                    throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+                }
+
+                HuffmanDecoder decoder = RestoreHuffmanDecoder(bit_reader);
+
+                if (job.opens_file) {
+                    job.file_name = ReadFileName(bit_reader, decoder);
+                }
+
+                next_chunk = SpecialCodes(decoder.Decode(bit_reader));
+
+                if (next_chunk != SpecialCodes::kOneMoreChunk && next_chunk != SpecialCodes::kOneMoreFile &&
+                    next_chunk != SpecialCodes::kArchiveEnd) {
+                    throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+                }
+
+                is_done = (next_chunk == SpecialCodes::kArchiveEnd ||
+                           (single_member && next_chunk == SpecialCodes::kOneMoreFile));
+
+                auto decode = [this, &job, layout, bit_reader, decoder = std::move(decoder)]() mutable {
+                    DecodeChunkData(bit_reader, decoder, layout, job.body, job.data);
+                };
+
+                if (pool != nullptr) {
+                    job.result = pool->Submit(std::move(decode));
+                } else {
+                    decode();
+                }
+            }
+
+            while (!jobs.empty() && (jobs.size() >= max_jobs || is_done)) {
+                ChunkJob& job = jobs.front();
+
+                if (job.result.valid()) {
+                    job.result.get();
+                }
+
+                if (job.opens_file) {
+                    if (has_open_file) {
+                        writer.CloseFile();
+                    }
+
+                    writer.OpenFile(job.file_name);
+                    has_open_file = true;
+                }
+
+                writer.WriteBytes(job.data);
+                jobs.pop_front();
+            }
+        }
+    } catch (...) {
+        for (ChunkJob& job : jobs) {
+            if (job.result.valid()) {
+                job.result.wait();
+            }
+        }
+
+        throw;
+    }
+
+    if (has_open_file) {
+        writer.CloseFile();
+    }
+}
+
+template <class Reader, class Writer>
+std::vector<ArchiverBase::MemberInfo> BasicArchiver<Reader, Writer>::CompressInParallel(
+    std::vector<std::unique_ptr<Reader>>& readers, Writer& writer) {
+    // Files are encoded into memory concurrently and moved into writer in their order,
+    // so the archive is the same as the one produced serially.
+    std::vector<MemoryWriter> buffers(readers.size());
+    std::vector<std::future<void>> results(readers.size());
+    std::vector<MemberInfo> directory(readers.size());
+    std::atomic<size_t> busy_files = 0;
+    size_t submitted = 0;
+
+    ThreadPool pool(threads_count_);
+
+    // Chunks of every file are tasks of the same pool, so when only a few big files are left,
+    // their chunks are stolen by the workers that have no files to take.
+    for (size_t i = 0; i < readers.size(); ++i) {
+        for (; submitted < readers.size() && submitted < i + kFilesInFlightPerThread * threads_count_; ++submitted) {
+            results[submitted] = pool.Submit([this, &readers, &buffers, &directory, &pool, &busy_files, submitted] {
+                ++busy_files;
+
+                try {
+                    directory[submitted] = AddCompressedFile(readers[submitted], buffers[submitted],
+                                                             submitted + 1 == readers.size(), &pool, &busy_files);
+                } catch (...) {
+                    --busy_files;
+                    throw;
+                }
+
+                --busy_files;
+            });
+        }
+
+        results[i].get();
+        buffers[i].MoveTo(writer);
+        readers[i].reset();
+    }
+
+    return directory;
+}
+
+template <class Reader, class Writer>
+std::vector<ArchiverBase::MemberInfo> BasicArchiver<Reader, Writer>::CompressPipelined(
+    std::vector<std::unique_ptr<Reader>>& readers, Writer& writer) {
+    // Reading, encoding (on this thread) and writing are stages connected by rings, so waiting for the disk
+    // overlaps with encoding. Chunk buffers go back to the previous stage through the free rings to be reused.
+    struct ReadChunk {
+        std::vector<unsigned char> data;
+        std::span<const unsigned char> view;
+        size_t file_index = 0;
+        bool is_first_chunk = false;
+        SpecialCodes next_chunk = SpecialCodes::kOneMoreChunk;
+    };
+
+    struct EncodedChunk {
+        MemoryWriter body;
+        size_t file_index = 0;
+        size_t original_size = 0;
+        bool ends_file = false;
+        bool is_last = false;
+    };
+
+    std::vector<MemberInfo> directory(readers.size());
+
+    if (readers.empty()) {
+        return directory;
+    }
+
+    SpscRing<ReadChunk> read_chunks(kPipelineDepth);
+    SpscRing<std::vector<unsigned char>> free_data(kPipelineDepth);
+    SpscRing<EncodedChunk> encoded_chunks(kPipelineDepth);
+    SpscRing<MemoryWriter> free_bodies(kPipelineDepth);
+
+    for (size_t i = 0; i < kPipelineDepth; ++i) {
+        free_data.Push({});
+        free_bodies.Push({});
+    }
+
+    // A failed stage closes all rings, so the other stages stop waiting and the failure is rethrown below.
+    auto close_rings = [&] {
+        read_chunks.Close();
+        free_data.Close();
+        encoded_chunks.Close();
+        free_bodies.Close();
+    };
+
+    ThreadPool stages(2);
+
+    std::future<void> reading = stages.Submit([&] {
+        try {
+            for (size_t i = 0; i < readers.size(); ++i) {
+                directory[i].file_name = readers[i]->GetFileName();
+
+                size_t offset = 0;
+
+                for (bool is_first_chunk = true, is_last_chunk = false; !is_last_chunk; is_first_chunk = false) {
+                    ReadChunk chunk{.file_index = i, .is_first_chunk = is_first_chunk};
+
+                    if (!free_data.Pop(chunk.data)) {
+                        return;
+                    }
+
+                    chunk.view = TakeChunk(*readers[i], offset, chunk.data, is_last_chunk);
+                    offset += chunk.view.size();
+
+                    if (is_last_chunk) {
+                        chunk.next_chunk =
+                            (i + 1 == readers.size() ? SpecialCodes::kArchiveEnd : SpecialCodes::kOneMoreFile);
+                    }
+
+                    if (!read_chunks.Push(std::move(chunk))) {
+                        return;
+                    }
+                }
+            }
+        } catch (...) {
+            close_rings();
+            throw;
+        }
+    });
+
+    std::future<void> writing = stages.Submit([&] {
+        try {
+            for (bool is_last = false; !is_last;) {
+                EncodedChunk chunk;
+
+                if (!encoded_chunks.Pop(chunk)) {
+                    return;
+                }
+
+                MemberInfo& member = directory[chunk.file_index];
+
+                member.original_size += chunk.original_size;
+                member.compressed_size += 2 * kChunkSizeBits / CHAR_BIT + chunk.body.GetData().size();
+
+                writer.WriteBits(chunk.original_size, kChunkSizeBits);
+                writer.WriteBits(chunk.body.GetData().size(), kChunkSizeBits);
+                chunk.body.MoveTo(writer);
+                is_last = chunk.is_last;
+
+                // Chunks may view the reader's memory, so it is released only when its last chunk is written.
+                if (chunk.ends_file) {
+                    readers[chunk.file_index].reset();
+                }
+
+                if (!free_bodies.Push(std::move(chunk.body))) {
+                    return;
+                }
+            }
+        } catch (...) {
+            close_rings();
+            throw;
+        }
+    });
+
+    try {
+        for (bool is_last = false; !is_last;) {
+            ReadChunk chunk;
+            EncodedChunk encoded;
+
+            if (!read_chunks.Pop(chunk) || !free_bodies.Pop(encoded.body)) {
+                break;
+            }
+
+            const std::string* file_name = (chunk.is_first_chunk ? &directory[chunk.file_index].file_name : nullptr);
+
+            EncodeChunk(chunk.view, file_name, chunk.next_chunk, encoded.body);
+
+            encoded.file_index = chunk.file_index;
+            encoded.original_size = chunk.view.size();
+            encoded.ends_file = (chunk.next_chunk != SpecialCodes::kOneMoreChunk);
+            encoded.is_last = is_last = (chunk.next_chunk == SpecialCodes::kArchiveEnd);
+
+            if (!free_data.Push(std::move(chunk.data)) || !encoded_chunks.Push(std::move(encoded))) {
+                break;
+            }
+        }
+    } catch (...) {
+        close_rings();
+        reading.wait();
+        writing.wait();
+        throw;
+    }
+
+    reading.get();
+    writing.get();
+
+    return directory;
+}
+
+template <class Reader, class Writer>
+template <class OutputWriter>
+ArchiverBase::MemberInfo BasicArchiver<Reader, Writer>::AddCompressedFile(std::unique_ptr<Reader>& reader,
+                                                                          OutputWriter& writer, bool is_last,
+                                                                          ThreadPool* pool,
+                                                                          const std::atomic<size_t>* busy_files) {
+    struct ChunkJob {
+        std::vector<unsigned char> data;
+        std::span<const unsigned char> view;
+        MemoryWriter body;
+        std::future<void> result;
+    };
+
+    MemberInfo member{.file_name = reader->GetFileName()};
+    size_t offset = 0;
+    std::deque<ChunkJob> jobs;
+
+    // Files encoded at the same time share the chunks in flight, so memory use doesn't grow with their count.
+    auto get_max_jobs = [this, pool, busy_files] {
+        if (pool == nullptr) {
+            return size_t(1);
+        }
+
+        size_t files = (busy_files != nullptr ? std::max(busy_files->load(), size_t(1)) : 1);
+
+        return std::max(kChunksInFlightPerThread, kChunksInFlightPerThread * threads_count_ / files);
+    };
+
+    try {
+        // Every chunk is read once and then both counted and encoded from memory,
+        // so the reader is never rewound and may be a non-seekable stream.
+        for (bool is_first_chunk = true, is_last_chunk = false; !is_last_chunk; is_first_chunk = false) {
+            ChunkJob& job = jobs.emplace_back();
+
+            job.view = TakeChunk(*reader, offset, job.data, is_last_chunk);
+            offset += job.view.size();
+
+            SpecialCodes next_chunk = SpecialCodes::kOneMoreChunk;
+
+            if (is_last_chunk) {
+                next_chunk = (is_last ? SpecialCodes::kArchiveEnd : SpecialCodes::kOneMoreFile);
+            }
+
+            const std::string* file_name = (is_first_chunk ? &reader->GetFileName() : nullptr);
+            auto encode = [this, &job, file_name, next_chunk] {
+                EncodeChunk(job.view, file_name, next_chunk, job.body);
+            };
+
+            if (pool != nullptr) {
+                job.result = pool->Submit(encode);
+            } else {
+                encode();
+            }
+
+            while (!jobs.empty() && (jobs.size() >= get_max_jobs() || is_last_chunk)) {
+                ChunkJob& done_job = jobs.front();
+
+                if (done_job.result.valid()) {
+                    pool->Wait(done_job.result);
+                    done_job.result.get();
+                }
+
+                member.original_size += done_job.view.size();
+                member.compressed_size += 2 * kChunkSizeBits / CHAR_BIT + done_job.body.GetData().size();
+
+                writer.WriteBits(done_job.view.size(), kChunkSizeBits);
+                writer.WriteBits(done_job.body.GetData().size(), kChunkSizeBits);
+                done_job.body.MoveTo(writer);
+                jobs.pop_front();
+            }
+        }
+    } catch (...) {
+        for (ChunkJob& job : jobs) {
+            if (job.result.valid()) {
+                pool->Wait(job.result);
+            }
+        }
+
+        throw;
+    }
+
+    return member;
+}
+
+template <class Reader, class Writer>
+std::span<const unsigned char> BasicArchiver<Reader, Writer>::TakeChunk(Reader& reader, size_t offset,
+                                                                       std::vector<unsigned char>& buffer,
+                                                                       bool& is_last_chunk) {
+    std::span<const unsigned char> resident = reader.GetResidentData();
+
+    if (!resident.empty()) {
+        auto chunk = resident.subspan(offset, std::min(chunk_size_, resident.size() - offset));
+        is_last_chunk = (offset + chunk.size() == resident.size());
+
+        return chunk;
+    }
+
+    buffer.resize(chunk_size_);
+    buffer.resize(reader.ReadBytes(buffer));
+    is_last_chunk = (buffer.size() < chunk_size_ || !reader.HasNextByte());
+
+    return buffer;
+}
+
+template <class Reader, class Writer>
+void BasicArchiver<Reader, Writer>::WriteDirectory(Writer& writer, const std::vector<MemberInfo>& directory) {
+    // Files are written one after another from the start of the archive, so the offsets follow from the sizes.
+    uint64_t offset = 0;
+
+    writer.WriteBits(directory.size(), kNumberBits);
+
+    for (const MemberInfo& member : directory) {
+        writer.WriteBits(member.file_name.size(), kFileNameLengthBits);
+        writer.WriteBytes({reinterpret_cast<const unsigned char*>(member.file_name.data()), member.file_name.size()});
+        writer.WriteBits(offset, kNumberBits);
+        writer.WriteBits(member.original_size, kNumberBits);
+        writer.WriteBits(member.compressed_size, kNumberBits);
+        offset += member.compressed_size;
+    }
+
+    writer.WriteBits(offset, kNumberBits);
+    writer.WriteBits(kDirectoryMagic, kDirectoryMagicBits);
+}
+
+template <class Reader, class Writer>
+std::vector<ArchiverBase::MemberInfo> BasicArchiver<Reader, Writer>::ReadDirectory(std::unique_ptr<Reader>& reader) {
+    size_t trailer_size = (kNumberBits + kDirectoryMagicBits) / CHAR_BIT;
+    size_t archive_size = reader->GetSize();
+
+    if (archive_size < trailer_size) {
+        throw std::invalid_argument("ARCHIVER::READ_DIRECTORY: Archive has no directory");
+    }
+
+    reader->Seek(archive_size - trailer_size);
+
+    uint64_t offset = ReadNumber(reader, kNumberBits);
+
+    if (ReadNumber(reader, kDirectoryMagicBits) != kDirectoryMagic || offset > archive_size - trailer_size) {
+        throw std::invalid_argument("ARCHIVER::READ_DIRECTORY: Archive has no directory");
+    }
+
+    reader->Seek(offset);
+
+    std::vector<MemberInfo> directory(ReadNumber(reader, kNumberBits));
+
+    for (MemberInfo& member : directory) {
+        member.file_name.resize(ReadNumber(reader, kFileNameLengthBits));
+
+        std::span name_bytes(reinterpret_cast<unsigned char*>(member.file_name.data()), member.file_name.size());
+
+        if (reader->ReadBytes(name_bytes) != name_bytes.size()) {
+            throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+        }
+
+        member.offset = ReadNumber(reader, kNumberBits);
+        member.original_size = ReadNumber(reader, kNumberBits);
+        member.compressed_size = ReadNumber(reader, kNumberBits);
+    }
+
+    return directory;
+}
+
+template <class Reader, class Writer>
+uint64_t BasicArchiver<Reader, Writer>::ReadNumber(std::unique_ptr<Reader>& reader, size_t bits) {
+    std::array<unsigned char, kNumberBits / CHAR_BIT> bytes;
+    std::span number_bytes = std::span(bytes).first(bits / CHAR_BIT);
+
+    if (reader->ReadBytes(number_bytes) != number_bytes.size()) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    uint64_t number = 0;
+
+    for (unsigned char byte : number_bytes) {
+        number = (number << CHAR_BIT) | byte;
+    }
+
+    return number;
+}
+
+template <class Reader, class Writer>
+size_t BasicArchiver<Reader, Writer>::ReadChunk(std::unique_ptr<Reader>& reader,
+                                                std::vector<unsigned char>& body) {
+    size_t original_size = ReadNumber(reader, kChunkSizeBits);
+
+    body.resize(ReadNumber(reader, kChunkSizeBits));
+
+    if (reader->ReadBytes(body) != body.size()) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    return original_size;
+}
@@ -0,0 +1,92 @@
+#include "byte_histogram.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+const size_t kTables = 4;
+// Every table counts at most a quarter of bytes, so slices of this size can't overflow its counters.
+const size_t kMaxSliceSize = std::numeric_limits<uint32_t>::max();
+
+void CountBytesSimple(std::span<const unsigned char> data, std::span<size_t, kByteValues> counts) {
+    for (unsigned char byte : data) {
+        ++counts[byte];
+    }
+}
+
+void CountBytesMultiTable(std::span<const unsigned char> data, std::span<size_t, kByteValues> counts) {
+    std::array<std::array<uint32_t, kByteValues>, kTables> tables{};
+    size_t i = 0;
+
+    // Written out by hand, a loop over the tables is not unrolled by the compiler and is much slower.
+    for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t)) {
+        uint64_t bytes = 0;
+
+        std::memcpy(&bytes, data.data() + i, sizeof(bytes));
+
+        ++tables[0][bytes & 0xFF];
+        ++tables[1][(bytes >> 8) & 0xFF];
+        ++tables[2][(bytes >> 16) & 0xFF];
+        ++tables[3][(bytes >> 24) & 0xFF];
+        ++tables[0][(bytes >> 32) & 0xFF];
+        ++tables[1][(bytes >> 40) & 0xFF];
+        ++tables[2][(bytes >> 48) & 0xFF];
+        ++tables[3][bytes >> 56];
+    }
+
+    CountBytesSimple(data.subspan(i), counts);
+
+    for (size_t byte = 0; byte < kByteValues; ++byte) {
+        for (const auto& table : tables) {
+            counts[byte] += table[byte];
+        }
+    }
+}
+}  // namespace
+
+void CountBytes(std::span<const unsigned char> data, std::span<size_t, kByteValues> counts, HistogramKernel kernel) {
+    if (kernel == HistogramKernel::kSimple) {
+        CountBytesSimple(data, counts);
+        return;
+    }
+
+    while (!data.empty()) {
+        size_t slice_size = std::min(data.size(), kMaxSliceSize);
+
+        CountBytesMultiTable(data.first(slice_size), counts);
+        data = data.subspan(slice_size);
+    }
+}
+
+double EstimateEntropy(std::span<const unsigned char> data, size_t window_size, size_t windows_count) {
+    std::array<size_t, kByteValues> counts{};
+    size_t sampled_size = 0;
+
+    if (window_size * windows_count >= data.size()) {
+        window_size = data.size();
+        windows_count = 1;
+    }
+
+    for (size_t i = 0; i < windows_count; ++i) {
+        std::span<const unsigned char> window = data.subspan(i * (data.size() / windows_count), window_size);
+
+        CountBytes(window, counts);
+        sampled_size += window.size();
+    }
+
+    double entropy = 0;
+
+    for (size_t count : counts) {
+        if (count != 0) {
+            double probability = double(count) / double(sampled_size);
+
+            entropy -= probability * std::log2(probability);
+        }
+    }
+
+    return entropy;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+enum class HistogramKernel { kSimple, kMultiTable };
+
+const size_t kByteValues = 256;
+
+// Adds the number of occurrences of every byte value in data to counts.
+// kSimple increments a single table byte by byte. kMultiTable reads 8 bytes at once and spreads them over
+// 4 uint32_t tables, so runs of the same byte don't wait for the previous increment of the same counter.
+void CountBytes(std::span<const unsigned char> data, std::span<size_t, kByteValues> counts,
+                HistogramKernel kernel = HistogramKernel::kMultiTable);
+
+// Entropy in bits per byte of windows_count windows of window_size bytes spread evenly over data, a cheap
+// estimate of how well the whole data can be compressed. Few samples make the estimate slightly low.
+double EstimateEntropy(std::span<const unsigned char> data, size_t window_size, size_t windows_count);
@@ -0,0 +1,218 @@
+#include "huffman_decoder.h"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+HuffmanDecoder::HuffmanDecoder(const std::vector<int16_t>& symbols, const std::vector<int16_t>& length_counts,
+                               DecodeEngine engine)
+    : table_(size_t(1) << kLookupBits), engine_(engine) {
+    uint64_t code = 0;
+    size_t symbol_index = 0;
+
+    if (length_counts.size() > kMaxCodeLength) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    for (size_t length = 1; length <= length_counts.size(); ++length) {
+        for (int16_t i = 0; i < length_counts[length - 1]; ++i) {
+            if (symbol_index >= symbols.size() || code >= (uint64_t(1) << length)) {
+                throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+            }
+
+            TableEntry entry{.symbol = symbols[symbol_index], .length = uint8_t(length)};
+
+            if (length <= kLookupBits) {
+                size_t first = code << (kLookupBits - length);
+                size_t last = (code + 1) << (kLookupBits - length);
+
+                std::fill(table_.begin() + first, table_.begin() + last, entry);
+            } else {
+                TableEntry& primary = table_[code >> (length - kLookupBits)];
+
+                if (primary.symbol == kNoSymbol) {
+                    primary.symbol = int16_t(secondary_table_.size() >> kSecondaryBits);
+                    secondary_table_.resize(secondary_table_.size() + (size_t(1) << kSecondaryBits));
+                }
+
+                size_t secondary_code = code & ((uint64_t(1) << (length - kLookupBits)) - 1);
+                size_t first = (size_t(primary.symbol) << kSecondaryBits) | (secondary_code << (kMaxCodeLength - length));
+                size_t last = first + (size_t(1) << (kMaxCodeLength - length));
+
+                std::fill(secondary_table_.begin() + first, secondary_table_.begin() + last, entry);
+            }
+
+            ++code;
+            ++symbol_index;
+        }
+
+        code <<= 1;
+    }
+
+    if (engine_ == DecodeEngine::kMultiSymbol) {
+        BuildMultiSymbolTable();
+    }
+}
+
+int16_t HuffmanDecoder::Decode(BitReader& reader) const {
+    TableEntry entry = Lookup(reader.PeekBits(kMaxCodeLength));
+
+    reader.SkipBits(entry.length);
+
+    return entry.symbol;
+}
+
+size_t HuffmanDecoder::DecodeBytes(BitReader& reader, std::span<unsigned char> output, int16_t& stop_symbol) const {
+    size_t output_size = 0;
+
+    stop_symbol = kNoSymbol;
+
+    // One refill holds kCodesPerRefill codes of any length, so the end of the stream is checked once for all of them.
+    while (output.size() - output_size >= kCodesPerRefill * kMaxSymbolsPerLookup &&
+           reader.Refill() >= kCodesPerRefill * kMaxCodeLength) {
+        for (size_t i = 0; i < kCodesPerRefill; ++i) {
+            if (engine_ == DecodeEngine::kMultiSymbol) {
+                const MultiSymbolTableEntry& entry = multi_symbol_table_[reader.Peek(kLookupBits)];
+
+                if (entry.count != 0) {
+                    std::copy_n(entry.bytes, kMaxSymbolsPerLookup, output.begin() + output_size);
+                    output_size += entry.count;
+                    reader.Consume(entry.length);
+                    continue;
+                }
+            }
+
+            TableEntry entry = Lookup(reader.Peek(kMaxCodeLength));
+
+            reader.Consume(entry.length);
+
+            if (entry.symbol > UCHAR_MAX) {
+                stop_symbol = entry.symbol;
+                return output_size;
+            }
+
+            output[output_size++] = entry.symbol;
+        }
+    }
+
+    // Near the end of the stream or of output every code is checked on its own.
+    while (output_size < output.size()) {
+        if (engine_ == DecodeEngine::kMultiSymbol && output_size + kMaxSymbolsPerLookup <= output.size()) {
+            const MultiSymbolTableEntry& entry = multi_symbol_table_[reader.PeekBits(kLookupBits)];
+
+            if (entry.count != 0) {
+                std::copy_n(entry.bytes, kMaxSymbolsPerLookup, output.begin() + output_size);
+                output_size += entry.count;
+                reader.SkipBits(entry.length);
+                continue;
+            }
+        }
+
+        int16_t symbol = Decode(reader);
+
+        if (symbol > UCHAR_MAX) {
+            stop_symbol = symbol;
+            break;
+        }
+
+        output[output_size++] = symbol;
+    }
+
+    return output_size;
+}
+
+void HuffmanDecoder::DecodeInterleaved(std::array<BitReader, kInterleavedStreams>& readers,
+                                       const std::array<std::span<unsigned char>, kInterleavedStreams>& outputs) const {
+    size_t common_size = outputs[0].size();
+
+    for (const std::span<unsigned char>& output : outputs) {
+        common_size = std::min(common_size, output.size());
+    }
+
+    auto refill_all = [&readers] {
+        bool has_bits = true;
+
+        for (BitReader& reader : readers) {
+            has_bits &= (reader.Refill() >= kCodesPerRefill * kMaxCodeLength);
+        }
+
+        return has_bits;
+    };
+
+    size_t i = 0;
+
+    while (i + kCodesPerRefill <= common_size && refill_all()) {
+        for (size_t end = i + kCodesPerRefill; i < end; ++i) {
+            for (size_t stream = 0; stream < kInterleavedStreams; ++stream) {
+                TableEntry entry = Lookup(readers[stream].Peek(kMaxCodeLength));
+
+                readers[stream].Consume(entry.length);
+                outputs[stream][i] = ToByte(entry);
+            }
+        }
+    }
+
+    for (; i < common_size; ++i) {
+        for (size_t stream = 0; stream < kInterleavedStreams; ++stream) {
+            outputs[stream][i] = DecodeByte(readers[stream]);
+        }
+    }
+
+    for (size_t stream = 0; stream < kInterleavedStreams; ++stream) {
+        for (size_t i = common_size; i < outputs[stream].size(); ++i) {
+            outputs[stream][i] = DecodeByte(readers[stream]);
+        }
+    }
+}
+
+unsigned char HuffmanDecoder::DecodeByte(BitReader& reader) const {
+    TableEntry entry = Lookup(reader.PeekBits(kMaxCodeLength));
+
+    reader.SkipBits(entry.length);
+
+    return ToByte(entry);
+}
+
+unsigned char HuffmanDecoder::ToByte(TableEntry entry) const {
+    if (entry.symbol > UCHAR_MAX) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    return entry.symbol;
+}
+
+HuffmanDecoder::TableEntry HuffmanDecoder::Lookup(uint64_t bits) const {
+    TableEntry entry = table_[bits >> kSecondaryBits];
+
+    if (entry.length == 0 && entry.symbol != kNoSymbol) {
+        entry = secondary_table_[(size_t(entry.symbol) << kSecondaryBits) | (bits & ((1 << kSecondaryBits) - 1))];
+    }
+
+    if (entry.length == 0) {
+        throw std::invalid_argument("ARCHIVER::DECOMPRESS: Invalid file format");
+    }
+
+    return entry;
+}
+
+void HuffmanDecoder::BuildMultiSymbolTable() {
+    const size_t mask = (size_t(1) << kLookupBits) - 1;
+
+    multi_symbol_table_.resize(table_.size());
+
+    for (size_t index = 0; index < table_.size(); ++index) {
+        MultiSymbolTableEntry& entry = multi_symbol_table_[index];
+
+        while (entry.count < kMaxSymbolsPerLookup) {
+            // Bits after the first kLookupBits - entry.length are unknown here, so only codes that fit are taken.
+            TableEntry next = table_[(index << entry.length) & mask];
+
+            if (next.length == 0 || next.length + entry.length > kLookupBits || next.symbol > UCHAR_MAX) {
+                break;
+            }
+
+            entry.bytes[entry.count++] = next.symbol;
+            entry.length += next.length;
+        }
+    }
+}
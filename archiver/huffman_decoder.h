@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "reader/bit_reader.h"
+
+enum class DecodeEngine { kSingleSymbol, kMultiSymbol };
+
+// Decodes canonical Huffman codes with a lookup table indexed by the next kLookupBits bits of the stream.
+// Codes longer than kLookupBits (at most kMaxCodeLength bits) are rare, their first kLookupBits bits
+// point to a secondary table indexed by the remaining kMaxCodeLength - kLookupBits bits.
+// With DecodeEngine::kMultiSymbol one lookup may also yield up to kMaxSymbolsPerLookup bytes at once.
+class HuffmanDecoder {
+public:
+    static const size_t kLookupBits = 11;
+    static const size_t kMaxCodeLength = 15;
+    static const size_t kMaxSymbolsPerLookup = 3;
+    static const int16_t kNoSymbol = -1;
+    static const size_t kInterleavedStreams = 4;
+
+    // symbols are listed in canonical order, length_counts[i] is the number of codes of length i + 1.
+    HuffmanDecoder(const std::vector<int16_t>& symbols, const std::vector<int16_t>& length_counts,
+                   DecodeEngine engine = DecodeEngine::kSingleSymbol);
+
+    int16_t Decode(BitReader& reader) const;
+    // Decodes byte symbols into output until it is full or a non-byte symbol is met. Returns the number of
+    // decoded bytes, stop_symbol is set to the met non-byte symbol or to kNoSymbol.
+    size_t DecodeBytes(BitReader& reader, std::span<unsigned char> output, int16_t& stop_symbol) const;
+    // Fills every outputs[i] with byte symbols of independent stream readers[i]. Symbols of different streams
+    // don't depend on each other, so one step decodes a symbol from every stream at once.
+    void DecodeInterleaved(std::array<BitReader, kInterleavedStreams>& readers,
+                           const std::array<std::span<unsigned char>, kInterleavedStreams>& outputs) const;
+
+private:
+    static const size_t kSecondaryBits = kMaxCodeLength - kLookupBits;
+    static const size_t kCodesPerRefill = BitReader::kMaxPeekBits / kMaxCodeLength;
+
+    // Entry with zero length has no code, unless its symbol is the index of a secondary table.
+    struct TableEntry {
+        int16_t symbol = kNoSymbol;
+        uint8_t length = 0;
+    };
+
+    struct MultiSymbolTableEntry {
+        unsigned char bytes[kMaxSymbolsPerLookup] = {};
+        uint8_t count = 0;
+        uint8_t length = 0;
+    };
+
+    // Looks up the code at the start of kMaxCodeLength bits.
+    TableEntry Lookup(uint64_t bits) const;
+    unsigned char DecodeByte(BitReader& reader) const;
+    unsigned char ToByte(TableEntry entry) const;
+    void BuildMultiSymbolTable();
+
+private:
+    std::vector<TableEntry> table_;
+    std::vector<TableEntry> secondary_table_;
+    std::vector<MultiSymbolTableEntry> multi_symbol_table_;
+    DecodeEngine engine_;
+};
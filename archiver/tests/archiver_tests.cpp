@@ -1,11 +1,14 @@
 #include "archiver/archiver.h"
+#include "archiver/byte_histogram.h"
 #include <gtest/gtest.h>
 
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <random>
 
 #include "reader/file_reader.h"
+#include "reader/mmap_reader.h"
 #include "writer/file_writer.h"
 
 bool AreFilesEqual(const std::string& file_path1, const std::string& file_path2) {
@@ -69,6 +72,271 @@ void TestFilesCompression(const std::vector<std::string>& file_names, const std:
     }
 }
 
+void TestParallelCompression(const std::vector<std::string>& file_names, size_t threads_count,
+                             size_t chunk_size = Archiver::kDefaultChunkSize,
+                             ChunkLayout layout = ChunkLayout::kSingleStream) {
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+
+    for (size_t threads : {size_t(1), threads_count}) {
+        Archiver archiver;
+        std::vector<std::unique_ptr<ReaderInterface>> readers;
+
+        for (const auto& file_name : file_names) {
+            readers.emplace_back(std::make_unique<FileReader>(dir + file_name));
+        }
+
+        archiver.SetThreadsCount(threads);
+        archiver.SetChunkSize(chunk_size);
+        archiver.SetChunkLayout(layout);
+        archiver.Compress(std::move(readers), std::make_unique<FileWriter>(dir),
+                          "parallel_" + std::to_string(threads) + ".arc");
+    }
+
+    ASSERT_TRUE(AreFilesEqual(dir + "parallel_1.arc", dir + "parallel_" + std::to_string(threads_count) + ".arc"));
+
+    Archiver archiver;
+    archiver.SetThreadsCount(threads_count);
+    archiver.Decompress(std::make_unique<FileReader>(dir + "parallel_" + std::to_string(threads_count) + ".arc"),
+                        std::make_unique<FileWriter>(dir + "decompressed/"));
+
+    for (const auto& file_name : file_names) {
+        ASSERT_TRUE(AreFilesEqual(dir + file_name, dir + "decompressed/" + file_name));
+    }
+}
+
+TEST(Archiver, ParallelCompressionTest) {
+    TestParallelCompression({"kek", "T", "test_1.bin", "kek", "T"}, 3);
+}
+
+TEST(Archiver, ChunkedCompressionTest) {
+    TestParallelCompression({"Zadachnik-Kostrikin.pdf"}, 3, 100000);
+    TestParallelCompression({"kek", "Zadachnik-Kostrikin.pdf", "T"}, 2, 4096);
+    TestParallelCompression({"T", "kek"}, 2, 1);
+}
+
+TEST(Archiver, InterleavedLayoutTest) {
+    TestParallelCompression({"Zadachnik-Kostrikin.pdf", "kek"}, 3, 1 << 20, ChunkLayout::kInterleaved);
+    TestParallelCompression({"kek", "Zadachnik-Kostrikin.pdf", "T"}, 2, 4099, ChunkLayout::kInterleaved);
+    TestParallelCompression({"T", "kek", "test_1.bin"}, 2, 3, ChunkLayout::kInterleaved);
+}
+
+TEST(Archiver, StoredChunksTest) {
+    // Random bytes don't shrink, so their chunks are stored and the archive is only a bit larger than the file.
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+    std::mt19937 random_gen(2024);
+    std::vector<unsigned char> data(300000);
+
+    for (unsigned char& byte : data) {
+        byte = std::uniform_int_distribution<int>(0, UCHAR_MAX)(random_gen);
+    }
+
+    FileWriter writer(dir);
+    writer.OpenFile("random");
+    writer.WriteBytes(data);
+    writer.CloseFile();
+
+    TestParallelCompression({"random", "kek"}, 3, 100000);
+    TestParallelCompression({"kek", "random"}, 2, 70000, ChunkLayout::kInterleaved);
+
+    ASSERT_LT(std::filesystem::file_size(dir + "parallel_2.arc"), data.size() + 1000);
+}
+
+TEST(Archiver, MemoryCompressionTest) {
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+    std::vector<std::unique_ptr<MmapReader>> readers;
+    std::vector<MemoryFile> files;
+
+    for (std::string file_name : {"kek", "Zadachnik-Kostrikin.pdf", "T"}) {
+        readers.push_back(std::make_unique<MmapReader>(dir + file_name));
+        files.push_back({file_name, std::as_bytes(readers.back()->GetData())});
+    }
+
+    files.push_back({"empty", {}});
+
+    for (size_t threads : {1, 3}) {
+        Archiver archiver;
+        archiver.SetThreadsCount(threads);
+        archiver.SetChunkSize(100000);
+
+        std::vector<std::byte> archive(1);
+        archiver.Compress(files, archive);
+
+        std::vector<std::byte> fixed_archive(archive.size() - 1);
+        ASSERT_EQ(archiver.Compress(files, std::span(fixed_archive)).size(), fixed_archive.size());
+        ASSERT_TRUE(std::equal(fixed_archive.begin(), fixed_archive.end(), archive.begin() + 1));
+        ASSERT_THROW(archiver.Compress(files, std::span(fixed_archive).first(fixed_archive.size() - 1)),
+                     std::length_error);
+
+        std::vector<std::byte> output;
+        std::vector<MemoryFile> decompressed = archiver.Decompress(fixed_archive, output);
+
+        ASSERT_EQ(decompressed.size(), files.size());
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            ASSERT_EQ(decompressed[i].name, files[i].name);
+            ASSERT_TRUE(std::ranges::equal(decompressed[i].data, files[i].data));
+        }
+
+        std::vector<std::byte> fixed_output(output.size());
+        decompressed = archiver.Decompress(fixed_archive, std::span(fixed_output));
+
+        ASSERT_EQ(decompressed[1].data.data(), fixed_output.data() + files[0].data.size());
+        ASSERT_TRUE(std::ranges::equal(decompressed[1].data, files[1].data));
+    }
+}
+
+TEST(Archiver, ConcreteTypesTest) {
+    const std::vector<std::string> file_names = {"kek", "Zadachnik-Kostrikin.pdf", "T"};
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+
+    for (size_t threads : {1, 3}) {
+        BasicArchiver<MmapReader, FileWriter> compressor;
+        BasicArchiver<FileReader, FileWriter> decompressor;
+        std::vector<std::unique_ptr<MmapReader>> readers;
+
+        for (const auto& file_name : file_names) {
+            readers.push_back(std::make_unique<MmapReader>(dir + file_name));
+            std::filesystem::remove(dir + "decompressed/" + file_name);
+        }
+
+        compressor.SetThreadsCount(threads);
+        compressor.SetChunkSize(100000);
+        compressor.Compress(std::move(readers), std::make_unique<FileWriter>(dir), "concrete.arc");
+
+        decompressor.SetThreadsCount(threads);
+        decompressor.Decompress(std::make_unique<FileReader>(dir + "concrete.arc"),
+                                std::make_unique<FileWriter>(dir + "decompressed/"));
+
+        for (const auto& file_name : file_names) {
+            ASSERT_TRUE(AreFilesEqual(dir + file_name, dir + "decompressed/" + file_name));
+        }
+    }
+}
+
+TEST(Archiver, ExtractTest) {
+    const std::vector<std::string> file_names = {"kek", "Zadachnik-Kostrikin.pdf", "T", "test_1.bin"};
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+    Archiver archiver;
+    std::vector<std::unique_ptr<ReaderInterface>> readers;
+
+    for (const auto& file_name : file_names) {
+        readers.emplace_back(std::make_unique<FileReader>(dir + file_name));
+    }
+
+    archiver.SetChunkSize(100000);
+    archiver.Compress(std::move(readers), std::make_unique<FileWriter>(dir), "extract.arc");
+
+    for (const auto& file_name : file_names) {
+        std::filesystem::remove(dir + "decompressed/" + file_name);
+        archiver.Extract(std::make_unique<FileReader>(dir + "extract.arc"),
+                         std::make_unique<FileWriter>(dir + "decompressed/"), file_name);
+        ASSERT_TRUE(AreFilesEqual(dir + file_name, dir + "decompressed/" + file_name));
+    }
+
+    ASSERT_THROW(archiver.Extract(std::make_unique<FileReader>(dir + "extract.arc"),
+                                  std::make_unique<FileWriter>(dir + "decompressed/"), "missing"),
+                 std::invalid_argument);
+}
+
+TEST(Archiver, ParallelDecompressionTest) {
+    const std::vector<std::string> file_names = {"kek", "Zadachnik-Kostrikin.pdf", "T", "test_1.bin"};
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+    Archiver archiver;
+    std::vector<std::unique_ptr<ReaderInterface>> readers;
+
+    for (const auto& file_name : file_names) {
+        readers.emplace_back(std::make_unique<FileReader>(dir + file_name));
+        std::filesystem::remove(dir + "decompressed/" + file_name);
+    }
+
+    archiver.SetChunkSize(100000);
+    archiver.Compress(std::move(readers), std::make_unique<FileWriter>(dir), "parallel_decompression.arc");
+
+    archiver.SetThreadsCount(3);
+    archiver.DecompressInParallel(
+        [&dir] { return std::make_unique<FileReader>(dir + "parallel_decompression.arc"); },
+        [&dir] { return std::make_unique<FileWriter>(dir + "decompressed/"); });
+
+    for (const auto& file_name : file_names) {
+        ASSERT_TRUE(AreFilesEqual(dir + file_name, dir + "decompressed/" + file_name));
+    }
+}
+
+TEST(Archiver, LengthLimitedCodesTest) {
+    // Fibonacci frequencies make the Huffman tree a path, so unlimited codes would be 26 bits long.
+    std::string dir = std::string(CMAKE_BUILD_PATH) + "/mock/";
+    std::vector<unsigned char> data;
+
+    for (size_t symbol = 0, previous = 1, current = 1; symbol < 27; ++symbol) {
+        data.insert(data.end(), current, 'a' + symbol);
+        previous = std::exchange(current, previous + current);
+    }
+
+    FileWriter writer(dir);
+    writer.OpenFile("fibonacci");
+    writer.WriteBytes(data);
+    writer.CloseFile();
+
+    for (size_t max_code_length : {9, 11, 15}) {
+        Archiver archiver;
+        std::vector<std::unique_ptr<ReaderInterface>> readers;
+
+        readers.emplace_back(std::make_unique<FileReader>(dir + "fibonacci"));
+        archiver.SetMaxCodeLength(max_code_length);
+        archiver.Compress(std::move(readers), std::make_unique<FileWriter>(dir), "fibonacci.arc");
+        archiver.Decompress(std::make_unique<FileReader>(dir + "fibonacci.arc"),
+                            std::make_unique<FileWriter>(dir + "decompressed/"));
+
+        ASSERT_TRUE(AreFilesEqual(dir + "fibonacci", dir + "decompressed/fibonacci"));
+    }
+}
+
+TEST(Archiver, ByteHistogramTest) {
+    std::mt19937 generator(42);
+    std::vector<unsigned char> data(100003);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (i % 3 == 0 ? 'a' : generator() % 256);
+    }
+
+    for (size_t size : {0, 1, 7, 8, 9, 100003}) {
+        std::array<size_t, kByteValues> expected{};
+        std::array<size_t, kByteValues> counts{};
+
+        for (unsigned char byte : std::span(data).first(size)) {
+            ++expected[byte];
+        }
+
+        CountBytes(std::span(data).first(size), counts, HistogramKernel::kSimple);
+        ASSERT_EQ(counts, expected);
+
+        counts = {};
+        CountBytes(std::span(data).first(size), counts, HistogramKernel::kMultiTable);
+        ASSERT_EQ(counts, expected);
+    }
+}
+
+TEST(Archiver, EntropyProbeTest) {
+    std::mt19937 generator(42);
+    std::vector<unsigned char> data(1 << 20);
+
+    for (unsigned char& byte : data) {
+        byte = generator() % 256;
+    }
+
+    ASSERT_GT(EstimateEntropy(data, 1 << 10, 16), 7.95);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (i % 2 == 0 ? 'a' : data[i] % 16);
+    }
+
+    ASSERT_NEAR(EstimateEntropy(data, 1 << 10, 16), 3, 0.1);
+    std::vector<unsigned char> small_data = {1, 2, 3, 4};
+
+    ASSERT_DOUBLE_EQ(EstimateEntropy(small_data, 1 << 10, 16), 2);
+    ASSERT_EQ(EstimateEntropy({}, 1 << 10, 16), 0);
+}
+
 // TEST(Archiver, TheSimplestTest) {
 //     TestFileCompression("T");
 // }
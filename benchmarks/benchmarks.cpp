@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <filesystem>
 
 #include "archiver/archiver.h"
+#include "archiver/byte_histogram.h"
 #include "reader/file_reader.h"
+#include "reader/mmap_reader.h"
 #include "writer/file_writer.h"
 #include "utility/timer/timer.h"
 #include "utility/logger/logger.h"
@@ -10,6 +13,10 @@ namespace {
 int64_t ALL_FILES_SIZE_SUM = 0;
 int64_t ALL_FILES_COMPRESSION_TIME_SUM = 0;
 int64_t ALL_FILES_DECOMPRESSION_TIME_SUM = 0;
+std::vector<std::string> ARCHIVE_DIRECTORIES;
+
+const size_t kEngineBenchmarkRuns = 10;
+const size_t kHistogramBenchmarkRuns = 100;
 
 int64_t GetFileSize(const std::string& file_path) {
     std::ifstream file(file_path, std::ios_base::binary | std::ios_base::ate);
@@ -18,34 +25,83 @@ int64_t GetFileSize(const std::string& file_path) {
 }
 
 double CalculateCompressionPercentage(const std::string& directory) {
-    Archiver archiver;
-    std::vector<std::unique_ptr<ReaderInterface>> readers;
+    BasicArchiver<MmapReader, FileWriter> compressor;
+    BasicArchiver<FileReader, FileWriter> decompressor;
+    std::vector<std::unique_ptr<MmapReader>> readers;
     int64_t file_sizes_sum = 0;
 
     for (const auto& file : std::filesystem::directory_iterator(directory)) {
         if (!std::filesystem::is_directory(file.path())) {
-            readers.push_back(std::make_unique<FileReader>(file.path()));
+            readers.push_back(std::make_unique<MmapReader>(file.path()));
             file_sizes_sum += GetFileSize(file.path());
         }
     }
 
+    if (readers.empty()) {
+        return 0.0;
+    }
+
     ALL_FILES_SIZE_SUM += file_sizes_sum;
+    ARCHIVE_DIRECTORIES.push_back(directory);
 
     Timer timer;
 
-    archiver.Compress(std::move(readers), std::make_unique<FileWriter>(directory + "/compressed"), "archive");
+    compressor.Compress(std::move(readers), std::make_unique<FileWriter>(directory + "/compressed"), "archive");
 
     ALL_FILES_COMPRESSION_TIME_SUM += timer.GetMilliseconds();
 
     timer.Reset();
 
-    archiver.Decompress(std::make_unique<FileReader>(directory + "/compressed/archive"),
-                        std::make_unique<FileWriter>(directory + "/decompressed"));
+    decompressor.Decompress(std::make_unique<FileReader>(directory + "/compressed/archive"),
+                            std::make_unique<FileWriter>(directory + "/decompressed"));
 
     ALL_FILES_DECOMPRESSION_TIME_SUM += timer.GetMilliseconds();
 
     return double(GetFileSize(directory + "/compressed/archive")) / double(file_sizes_sum) * 100.0;
 }
+
+double CalculateDecompressionSpeed(DecodeEngine engine) {
+    BasicArchiver<FileReader, FileWriter> archiver;
+    Timer timer;
+
+    archiver.SetDecodeEngine(engine);
+
+    for (size_t i = 0; i < kEngineBenchmarkRuns; ++i) {
+        for (const auto& directory : ARCHIVE_DIRECTORIES) {
+            archiver.Decompress(std::make_unique<FileReader>(directory + "/compressed/archive"),
+                                std::make_unique<FileWriter>(directory + "/decompressed"));
+        }
+    }
+
+    return double(ALL_FILES_SIZE_SUM * kEngineBenchmarkRuns) / double(std::max(timer.GetMilliseconds(), int64_t(1))) *
+           double(1000) / double(int64_t(1) << 20);
+}
+
+double CalculateHistogramSpeed(HistogramKernel kernel) {
+    std::vector<MmapReader> files;
+    int64_t file_sizes_sum = 0;
+
+    for (const auto& directory : ARCHIVE_DIRECTORIES) {
+        for (const auto& file : std::filesystem::directory_iterator(directory)) {
+            if (!std::filesystem::is_directory(file.path())) {
+                files.emplace_back(file.path());
+                file_sizes_sum += files.back().GetData().size();
+            }
+        }
+    }
+
+    std::array<size_t, kByteValues> counts{};
+    Timer timer;
+
+    for (size_t i = 0; i < kHistogramBenchmarkRuns; ++i) {
+        for (const auto& file : files) {
+            CountBytes(file.GetData(), counts, kernel);
+        }
+    }
+
+    return double(file_sizes_sum * kHistogramBenchmarkRuns) / double(std::max(timer.GetMilliseconds(), int64_t(1))) *
+           double(1000) / double(int64_t(1) << 20);
+}
 }  // namespace
 
 int main() {
@@ -85,4 +141,22 @@ int main() {
     logger.Log("Decompression speed: ");
     logger.Log(decompression_speed);
     logger.LogLn("MB/s");
+    logger.LogLn("-------------------------------");
+
+    logger.LogLn("[Decode engine benchmarks]");
+    logger.Log("Single symbol per lookup: ");
+    logger.Log(CalculateDecompressionSpeed(DecodeEngine::kSingleSymbol));
+    logger.LogLn("MB/s");
+    logger.Log("Multiple symbols per lookup: ");
+    logger.Log(CalculateDecompressionSpeed(DecodeEngine::kMultiSymbol));
+    logger.LogLn("MB/s");
+    logger.LogLn("-------------------------------");
+
+    logger.LogLn("[Histogram benchmarks]");
+    logger.Log("Single table: ");
+    logger.Log(CalculateHistogramSpeed(HistogramKernel::kSimple));
+    logger.LogLn("MB/s");
+    logger.Log("Multiple tables: ");
+    logger.Log(CalculateHistogramSpeed(HistogramKernel::kMultiTable));
+    logger.LogLn("MB/s");
 }
\ No newline at end of file
@@ -1,11 +1,21 @@
 #pragma once
-#include <vector>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <stdexcept>
-#include <queue>
+#include <utility>
+#include <vector>
 
-template <class T>
+// Nodes of the trie are stored in one vector and refer to each other by index, so a trie of a few hundred
+// values is a single allocation and walking it doesn't jump between scattered heap blocks. The nodes are
+// allocated with Allocator, e.g. a std::pmr::polymorphic_allocator over an arena shared by a whole tree build.
+template <class T, class Allocator = std::allocator<T>>
 class BinaryTrie {
     struct Node;
+    using NodeIndex = uint32_t;
+    using NodeVector = std::vector<Node, typename std::allocator_traits<Allocator>::template rebind_alloc<Node>>;
+
+    static constexpr NodeIndex kNoNode = std::numeric_limits<NodeIndex>::max();
 
 public:
     struct BinaryPath {
@@ -28,11 +38,12 @@ public:
         BinaryPath GetPath() const;
 
     private:
-        Iterator(const Node* node, const BinaryPath& path);
+        Iterator(const NodeVector* nodes, NodeIndex node, const BinaryPath& path);
         Iterator() = default;
 
     private:
-        const Node* node_ = nullptr;
+        const NodeVector* nodes_ = nullptr;
+        NodeIndex node_ = kNoNode;
         BinaryPath path_;
     };
 
@@ -51,29 +62,32 @@ public:
         void GoRight();
 
     private:
-        Traverser(const Node* node, const BinaryPath& path);
+        Traverser(const NodeVector* nodes, NodeIndex node, const BinaryPath& path);
 
     private:
-        const Node* node_ = nullptr;
+        const NodeVector* nodes_ = nullptr;
+        NodeIndex node_ = kNoNode;
         BinaryPath path_;
     };
 
 private:
     struct Node {
-        T* value = nullptr;
-        Node* left_child = nullptr;
-        Node* right_child = nullptr;
-        Node* ancestor = nullptr;
+        NodeIndex left_child = kNoNode;
+        NodeIndex right_child = kNoNode;
+        NodeIndex ancestor = kNoNode;
+        bool has_value = false;
+        T value{};
     };
 
 public:
     BinaryTrie() = default;
-    explicit BinaryTrie(const T& root_value);
+    explicit BinaryTrie(const Allocator& allocator);
+    explicit BinaryTrie(const T& root_value, const Allocator& allocator = Allocator());
     BinaryTrie(const BinaryTrie& o) = delete;
     BinaryTrie& operator=(const BinaryTrie& o) = delete;
     BinaryTrie(BinaryTrie&& o) noexcept;
     BinaryTrie& operator=(BinaryTrie&& o) noexcept;
-    ~BinaryTrie();
+    ~BinaryTrie() = default;
 
     void Merge(BinaryTrie&& o);
     void Insert(const T& value, BinaryPath path);
@@ -84,144 +98,157 @@ public:
     Traverser GetRootTraverser() const;
 
 private:
-    Node* root_ = nullptr;
-    Node* begin_node_ = nullptr;
+    NodeIndex AppendNodes(NodeVector& nodes);
+
+private:
+    NodeVector nodes_;
+    NodeIndex root_ = kNoNode;
+    NodeIndex begin_node_ = kNoNode;
     BinaryPath begin_path_;
 };
 
-template <class T>
-BinaryTrie<T>::BinaryTrie(const T& root_value) {
-    begin_node_ = root_ = new Node();
-    root_->value = new T(root_value);
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>::BinaryTrie(const Allocator& allocator) : nodes_(allocator) {
 }
 
-template <class T>
-BinaryTrie<T>::BinaryTrie(BinaryTrie&& o) noexcept {
-    root_ = o.root_;
-    begin_node_ = o.begin_node_;
-    begin_path_ = o.begin_path_;
-    o.root_ = nullptr;
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>::BinaryTrie(const T& root_value, const Allocator& allocator)
+    : nodes_(1, allocator), root_(0), begin_node_(0) {
+    nodes_[0].has_value = true;
+    nodes_[0].value = root_value;
 }
 
-template <class T>
-BinaryTrie<T>& BinaryTrie<T>::operator=(BinaryTrie&& o) noexcept {
-    root_ = o.root_;
-    begin_node_ = o.begin_node_;
-    begin_path_ = o.begin_path_;
-    o.root_ = nullptr;
-
-    return *this;
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>::BinaryTrie(BinaryTrie&& o) noexcept
+    : nodes_(std::move(o.nodes_)),
+      root_(std::exchange(o.root_, kNoNode)),
+      begin_node_(std::exchange(o.begin_node_, kNoNode)),
+      begin_path_(o.begin_path_) {
+    o.nodes_.clear();
 }
 
-template <class T>
-BinaryTrie<T>::~BinaryTrie() {
-    std::queue<Node*> to_delete;
-
-    to_delete.push(root_);
-
-    while (!to_delete.empty()) {
-        Node* node = to_delete.front();
-        to_delete.pop();
-
-        if (node != nullptr) {
-            if (node->left_child != nullptr) {
-                to_delete.push(node->left_child);
-            }
-
-            if (node->right_child != nullptr) {
-                to_delete.push(node->right_child);
-            }
-        }
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>& BinaryTrie<T, Allocator>::operator=(BinaryTrie&& o) noexcept {
+    nodes_ = std::move(o.nodes_);
+    root_ = std::exchange(o.root_, kNoNode);
+    begin_node_ = std::exchange(o.begin_node_, kNoNode);
+    begin_path_ = o.begin_path_;
+    o.nodes_.clear();
 
-        delete node;
-    }
+    return *this;
 }
 
-template <class T>
-void BinaryTrie<T>::Merge(BinaryTrie&& o) {
-    if (o.root_ == nullptr) {
+template <class T, class Allocator>
+void BinaryTrie<T, Allocator>::Merge(BinaryTrie&& o) {
+    if (o.root_ == kNoNode) {
         return;
     }
 
-    if (root_ == nullptr) {
+    if (root_ == kNoNode) {
         (*this) = std::move(o);
         return;
     }
 
-    Node* new_root = new Node();
+    NodeIndex left_root = root_;
+    NodeIndex right_root = o.root_;
 
-    new_root->left_child = root_;
-    new_root->right_child = o.root_;
+    // The smaller trie is appended to the bigger one, so a node is moved O(log n) times over all merges.
+    if (nodes_.size() >= o.nodes_.size()) {
+        right_root += AppendNodes(o.nodes_);
+    } else {
+        NodeIndex offset = o.AppendNodes(nodes_);
 
-    root_ = new_root;
-    o.root_ = nullptr;
+        left_root += offset;
+        begin_node_ += offset;
+        nodes_ = std::move(o.nodes_);
+    }
+
+    root_ = NodeIndex(nodes_.size());
+    nodes_.push_back({.left_child = left_root, .right_child = right_root});
+    nodes_[left_root].ancestor = root_;
+    nodes_[right_root].ancestor = root_;
 
-    root_->left_child->ancestor = root_;
-    root_->right_child->ancestor = root_;
+    o.nodes_.clear();
+    o.root_ = o.begin_node_ = kNoNode;
 
     ++begin_path_.length;
     begin_path_.code <<= 1;
 }
 
-template <class T>
-void BinaryTrie<T>::Insert(const T& value, BinaryPath path) {
-    if (root_ == nullptr) {
-        root_ = new Node();
+template <class T, class Allocator>
+void BinaryTrie<T, Allocator>::Insert(const T& value, BinaryPath path) {
+    if (root_ == kNoNode) {
+        root_ = NodeIndex(nodes_.size());
+        nodes_.emplace_back();
     }
 
-    Node* current_node = root_;
+    NodeIndex current_node = root_;
 
     for (size_t i = 0; i < path.length; ++i) {
-        Node* next_node = current_node->left_child;
         bool right_child = ((path.code >> i) & 1);
+        NodeIndex next_node = right_child ? nodes_[current_node].right_child : nodes_[current_node].left_child;
 
-        if (right_child) {
-            next_node = current_node->right_child;
-        }
-
-        if (next_node == nullptr) {
-            if (i + 1 == path.length) {
-                next_node = new Node();
-                next_node->value = new T(value);
-            } else {
-                next_node = new Node();
-            }
+        if (next_node == kNoNode) {
+            next_node = NodeIndex(nodes_.size());
+            nodes_.push_back({.ancestor = current_node});
 
             if (right_child) {
-                current_node->right_child = next_node;
+                nodes_[current_node].right_child = next_node;
             } else {
-                current_node->left_child = next_node;
+                nodes_[current_node].left_child = next_node;
             }
-
-            current_node->ancestor = current_node;
         }
 
         current_node = next_node;
     }
 
-    if (path < begin_path_) {
+    nodes_[current_node].has_value = true;
+    nodes_[current_node].value = value;
+
+    if (begin_node_ == kNoNode || path < begin_path_) {
         begin_path_ = path;
         begin_node_ = current_node;
     }
 }
 
-template <class T>
-typename BinaryTrie<T>::Iterator BinaryTrie<T>::begin() const {
-    return Iterator(begin_node_, begin_path_);
+template <class T, class Allocator>
+typename BinaryTrie<T, Allocator>::NodeIndex BinaryTrie<T, Allocator>::AppendNodes(NodeVector& nodes) {
+    NodeIndex offset = NodeIndex(nodes_.size());
+
+    if (nodes_.size() + nodes.size() >= kNoNode) {
+        throw std::length_error("BINARY_TRIE::MERGE: Too many nodes");
+    }
+
+    for (Node node : nodes) {
+        for (NodeIndex* link : {&node.left_child, &node.right_child, &node.ancestor}) {
+            if (*link != kNoNode) {
+                *link += offset;
+            }
+        }
+
+        nodes_.push_back(std::move(node));
+    }
+
+    return offset;
+}
+
+template <class T, class Allocator>
+typename BinaryTrie<T, Allocator>::Iterator BinaryTrie<T, Allocator>::begin() const {
+    return Iterator(&nodes_, begin_node_, begin_path_);
 }
 
-template <class T>
-typename BinaryTrie<T>::Iterator BinaryTrie<T>::end() const {
-    return BinaryTrie::Iterator(nullptr, {});
+template <class T, class Allocator>
+typename BinaryTrie<T, Allocator>::Iterator BinaryTrie<T, Allocator>::end() const {
+    return BinaryTrie::Iterator(&nodes_, kNoNode, {});
 }
 
-template <class T>
-typename BinaryTrie<T>::Traverser BinaryTrie<T>::GetRootTraverser() const {
-    return Traverser(root_, {});
+template <class T, class Allocator>
+typename BinaryTrie<T, Allocator>::Traverser BinaryTrie<T, Allocator>::GetRootTraverser() const {
+    return Traverser(&nodes_, root_, {});
 }
 
-template <class T>
-bool BinaryTrie<T>::BinaryPath::operator<(const BinaryPath& o) const {
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::BinaryPath::operator<(const BinaryPath& o) const {
     for (size_t i = 0; i < std::min(length, o.length); ++i) {
         bool bit1 = ((code >> i) & 1);
         bool bit2 = ((o.code >> i) & 1);
@@ -242,32 +269,34 @@ bool BinaryTrie<T>::BinaryPath::operator<(const BinaryPath& o) const {
     return true;
 }
 
-template <class T>
-BinaryTrie<T>::Iterator::Iterator(const BinaryTrie::Node* node, const BinaryPath& path) : node_(node), path_(path) {
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>::Iterator::Iterator(const NodeVector* nodes, NodeIndex node, const BinaryPath& path)
+    : nodes_(nodes), node_(node), path_(path) {
 }
 
-template <class T>
-void BinaryTrie<T>::Iterator::operator++() {
-    if (node_ == nullptr) {
+template <class T, class Allocator>
+void BinaryTrie<T, Allocator>::Iterator::operator++() {
+    if (node_ == kNoNode) {
         return;
     }
 
     bool was_right_turn = false;
-    const Node* last_node_ = node_;
+    NodeIndex last_node_ = node_;
 
     do {
-        const Node* node_copy_ = node_;
+        const Node& node = (*nodes_)[node_];
+        NodeIndex node_copy_ = node_;
 
-        if (!was_right_turn && node_->right_child != nullptr && node_->right_child != last_node_) {
-            node_ = node_->right_child;
+        if (!was_right_turn && node.right_child != kNoNode && node.right_child != last_node_) {
+            node_ = node.right_child;
             path_.code |= (size_t(1) << path_.length);
             ++path_.length;
             was_right_turn = true;
-        } else if (was_right_turn && node_->left_child != nullptr && node_->left_child != last_node_) {
-            node_ = node_->left_child;
+        } else if (was_right_turn && node.left_child != kNoNode && node.left_child != last_node_) {
+            node_ = node.left_child;
             ++path_.length;
         } else {
-            node_ = node_->ancestor;
+            node_ = node.ancestor;
 
             if (path_.length != 0 && (path_.code & (size_t(1) << (path_.length - 1)))) {
                 path_.code ^= (size_t(1) << (path_.length - 1));
@@ -279,79 +308,80 @@ void BinaryTrie<T>::Iterator::operator++() {
         }
 
         last_node_ = node_copy_;
-    } while (node_ != nullptr && node_->value == nullptr);
+    } while (node_ != kNoNode && !(*nodes_)[node_].has_value);
 }
 
-template <class T>
-const T& BinaryTrie<T>::Iterator::operator*() const {
-    if (node_ == nullptr) {
+template <class T, class Allocator>
+const T& BinaryTrie<T, Allocator>::Iterator::operator*() const {
+    if (node_ == kNoNode) {
         throw std::runtime_error("BINARY_TRIE::ITERATOR::OPERATOR*: End iterator can't be dereferenced");
     }
 
-    if (node_->value == nullptr) {
+    if (!(*nodes_)[node_].has_value) {
         throw std::runtime_error("BINARY_TRIE::ITERATOR::OPERATOR*: Attempt to dereference iterator without value");
     }
 
-    return *node_->value;
+    return (*nodes_)[node_].value;
 }
 
-template <class T>
-bool BinaryTrie<T>::Iterator::operator!=(const BinaryTrie::Iterator& o) const {
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::Iterator::operator!=(const BinaryTrie::Iterator& o) const {
     return node_ != o.node_;
 }
 
-template <class T>
-bool BinaryTrie<T>::Iterator::operator==(const BinaryTrie::Iterator& o) const {
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::Iterator::operator==(const BinaryTrie::Iterator& o) const {
     return node_ == o.node_;
 }
 
-template <class T>
-typename BinaryTrie<T>::BinaryPath BinaryTrie<T>::Iterator::GetPath() const {
+template <class T, class Allocator>
+typename BinaryTrie<T, Allocator>::BinaryPath BinaryTrie<T, Allocator>::Iterator::GetPath() const {
     return path_;
 }
 
-template <class T>
-BinaryTrie<T>::Traverser::Traverser(const BinaryTrie::Node* node, const BinaryTrie::BinaryPath& path)
-    : node_(node), path_(path) {
+template <class T, class Allocator>
+BinaryTrie<T, Allocator>::Traverser::Traverser(const NodeVector* nodes, NodeIndex node,
+                                               const BinaryTrie::BinaryPath& path)
+    : nodes_(nodes), node_(node), path_(path) {
 }
 
-template <class T>
-const typename BinaryTrie<T>::BinaryPath& BinaryTrie<T>::Traverser::operator*() const {
+template <class T, class Allocator>
+const typename BinaryTrie<T, Allocator>::BinaryPath& BinaryTrie<T, Allocator>::Traverser::operator*() const {
     return path_;
 }
 
-template <class T>
-bool BinaryTrie<T>::Traverser::HasValue() const {
-    return node_ != nullptr && node_->value != nullptr;
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::Traverser::HasValue() const {
+    return node_ != kNoNode && (*nodes_)[node_].has_value;
 }
-template <class T>
-const T& BinaryTrie<T>::Traverser::GetValue() const {
-    if (node_ == nullptr || node_->value == nullptr) {
+template <class T, class Allocator>
+const T& BinaryTrie<T, Allocator>::Traverser::GetValue() const {
+    if (!HasValue()) {
         throw std::runtime_error("BINARY_TRIE::TRAVERSER::GET_VALUE: Attempt to get empty value");
     }
 
-    return *node_->value;
+    return (*nodes_)[node_].value;
 }
-template <class T>
-bool BinaryTrie<T>::Traverser::CanGoLeft() const {
-    return node_->left_child != nullptr;
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::Traverser::CanGoLeft() const {
+    return node_ != kNoNode && (*nodes_)[node_].left_child != kNoNode;
 }
-template <class T>
-bool BinaryTrie<T>::Traverser::CanGoRight() const {
-    return node_->right_child != nullptr;
+template <class T, class Allocator>
+bool BinaryTrie<T, Allocator>::Traverser::CanGoRight() const {
+    return node_ != kNoNode && (*nodes_)[node_].right_child != kNoNode;
 }
-template <class T>
-void BinaryTrie<T>::Traverser::GoLeft() {
-    if (node_ != nullptr) {
-        node_ = node_->left_child;
+template <class T, class Allocator>
+void BinaryTrie<T, Allocator>::Traverser::GoLeft() {
+    if (node_ != kNoNode) {
+        node_ = (*nodes_)[node_].left_child;
         ++path_.length;
     }
 }
-template <class T>
-void BinaryTrie<T>::Traverser::GoRight() {
-    if (node_ != nullptr) {
-        node_ = node_->right_child;
+template <class T, class Allocator>
+void BinaryTrie<T, Allocator>::Traverser::GoRight() {
+    if (node_ != kNoNode) {
+        node_ = (*nodes_)[node_].right_child;
         path_.code |= (size_t(1) << path_.length);
         ++path_.length;
     }
-}
\ No newline at end of file
+}
@@ -7,12 +7,16 @@
 #include <chrono>
 #include <bitset>
 #include <queue>
+#include <set>
+#include <numeric>
+#include <algorithm>
+#include <memory_resource>
 
 std::mt19937 random_gen(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 auto gen_number = std::bind(std::uniform_int_distribution<size_t>(0, 100), random_gen);
 
-template <class T>
-void CheckIteration(const BinaryTrie<T>& trie, const std::vector<T>& expected_iteration) {
+template <class T, class Allocator>
+void CheckIteration(const BinaryTrie<T, Allocator>& trie, const std::vector<T>& expected_iteration) {
     {
         size_t i = 0;
 
@@ -34,9 +38,9 @@ void CheckIteration(const BinaryTrie<T>& trie, const std::vector<T>& expected_it
     }
 }
 
-template <class T>
-void CheckIteratorPaths(const BinaryTrie<T>& trie,
-                        const std::vector<typename BinaryTrie<T>::BinaryPath>& expected_paths) {
+template <class T, class Allocator>
+void CheckIteratorPaths(const BinaryTrie<T, Allocator>& trie,
+                        const std::vector<typename BinaryTrie<T, Allocator>::BinaryPath>& expected_paths) {
     size_t i = 0;
 
     for (auto iter = trie.begin(); iter != trie.end(); ++iter) {
@@ -46,9 +50,9 @@ void CheckIteratorPaths(const BinaryTrie<T>& trie,
     }
 }
 
-template <class T>
-void CheckTraversing(const BinaryTrie<T>& trie, const std::vector<T>& expected_traversal,
-                     const std::vector<typename BinaryTrie<T>::BinaryPath>& expected_paths) {
+template <class T, class Allocator>
+void CheckTraversing(const BinaryTrie<T, Allocator>& trie, const std::vector<T>& expected_traversal,
+                     const std::vector<typename BinaryTrie<T, Allocator>::BinaryPath>& expected_paths) {
 
     for (size_t i = 0; i < expected_traversal.size(); ++i) {
         auto traverser = trie.GetRootTraverser();
@@ -181,6 +185,35 @@ TEST(BinaryTrie, BinaryTrieManualTest) {
     CheckIteration(trie, expected_iteration);
 }
 
+TEST(BinaryTrie, ArenaTest) {
+    using ArenaTrie = BinaryTrie<size_t, std::pmr::polymorphic_allocator<size_t>>;
+
+    std::pmr::monotonic_buffer_resource arena;
+    const size_t size = 40;
+    std::vector<size_t> expected_iteration(size);
+    std::vector<ArenaTrie::BinaryPath> expected_paths(size);
+
+    expected_iteration[0] = gen_number();
+    ArenaTrie trie(expected_iteration[0], &arena);
+
+    for (size_t i = 1; i < size; ++i) {
+        expected_iteration[i] = gen_number();
+        trie.Merge(ArenaTrie(expected_iteration[i], &arena));
+    }
+
+    // Every merge puts the trie to the left of a new value, so the i-th value is reached by going left
+    // size - 1 - i times and then right once.
+    expected_paths[0] = {.code = 0, .length = size - 1};
+
+    for (size_t i = 1; i < size; ++i) {
+        expected_paths[i] = {.code = size_t(1) << (size - 1 - i), .length = size - i};
+    }
+
+    CheckIteration(trie, expected_iteration);
+    CheckIteratorPaths(trie, expected_paths);
+    CheckTraversing(trie, expected_iteration, expected_paths);
+}
+
 TEST(BinaryTrie, BigTest) {
     for (size_t i = 1; i < 1000; ++i) {
         GenerateAndTestTrie(i);
@@ -195,7 +228,7 @@ TEST(BinaryTrie, InsertTest) {
 
     for(size_t i = 0; i < 1'000'000; ++i) {
         size_t path_length = std::uniform_int_distribution<size_t>(15, 25)(random_gen);
-        BinaryTrie<size_t>::BinaryPath path{.code = gen_number(), path_length};
+        BinaryTrie<size_t>::BinaryPath path{.code = gen_number(), .length = path_length};
 
         if(used_paths.find(path) != used_paths.end()) {
             used_paths.insert(path);
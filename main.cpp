@@ -3,15 +3,24 @@
 
 #include "archiver/archiver.h"
 #include "reader/file_reader.h"
+#include "reader/mmap_reader.h"
+#include "reader/stream_reader.h"
 #include "writer/file_writer.h"
+#include "writer/stream_writer.h"
 
-enum class CommandType { kCompress, kDecompress, kHelp, kUnknownType };
+// Used instead of a file name to read from standard input or write to standard output.
+const std::string kStandardStreamName = "-";
+
+enum class CommandType { kCompress, kDecompress, kExtract, kHelp, kUnknownType };
 
 struct CommandProperties {
     CommandType command_type = CommandType::kUnknownType;
     std::string archive_name;
     std::vector<std::string> files_to_compress;
+    std::string file_to_extract;
     std::string output_directory;
+    size_t threads_count = 1;
+    ChunkLayout chunk_layout = ChunkLayout::kSingleStream;
 };
 
 void ProcessOutputOption(CommandProperties& properties, std::queue<std::string>& tokens) {
@@ -26,6 +35,24 @@ void ProcessOutputOption(CommandProperties& properties, std::queue<std::string>&
     tokens.pop();
 }
 
+void ProcessThreadsOption(CommandProperties& properties, std::queue<std::string>& tokens) {
+    tokens.pop();
+
+    if (tokens.empty()) {
+        std::cout << "Option -j was used without threads count specified" << std::endl;
+        exit(0);
+    }
+
+    try {
+        properties.threads_count = std::stoul(tokens.front());
+    } catch (const std::exception&) {
+        std::cout << "Invalid threads count: " << tokens.front() << std::endl;
+        exit(0);
+    }
+
+    tokens.pop();
+}
+
 CommandProperties ParseArguments(int argc, char* argv[]) {
     if (argc < 2) {
         std::cout << "Too little options" << std::endl;
@@ -53,8 +80,15 @@ CommandProperties ParseArguments(int argc, char* argv[]) {
             properties.archive_name = tokens.front();
             tokens.pop();
 
-            if (!tokens.empty() && tokens.front() == "-o") {
-                ProcessOutputOption(properties, tokens);
+            while (!tokens.empty() && (tokens.front() == "-o" || tokens.front() == "-j" || tokens.front() == "-i")) {
+                if (tokens.front() == "-o") {
+                    ProcessOutputOption(properties, tokens);
+                } else if (tokens.front() == "-j") {
+                    ProcessThreadsOption(properties, tokens);
+                } else {
+                    properties.chunk_layout = ChunkLayout::kInterleaved;
+                    tokens.pop();
+                }
             }
 
             if (tokens.empty()) {
@@ -78,12 +112,48 @@ CommandProperties ParseArguments(int argc, char* argv[]) {
             properties.archive_name = tokens.front();
             tokens.pop();
 
-            if (!tokens.empty() && tokens.front() == "-o") {
-                ProcessOutputOption(properties, tokens);
+            while (!tokens.empty() && (tokens.front() == "-o" || tokens.front() == "-j")) {
+                if (tokens.front() == "-o") {
+                    ProcessOutputOption(properties, tokens);
+                } else {
+                    ProcessThreadsOption(properties, tokens);
+                }
+            }
+        } else if (tokens.front() == "-x") {
+            properties.command_type = CommandType::kExtract;
+            tokens.pop();
+
+            if (tokens.empty()) {
+                std::cout << "No archive name" << std::endl;
+                exit(0);
+            }
+
+            properties.archive_name = tokens.front();
+            tokens.pop();
+
+            while (!tokens.empty()) {
+                if (tokens.front() == "-o") {
+                    ProcessOutputOption(properties, tokens);
+                } else if (tokens.front() == "-j") {
+                    ProcessThreadsOption(properties, tokens);
+                } else if (properties.file_to_extract.empty()) {
+                    properties.file_to_extract = tokens.front();
+                    tokens.pop();
+                } else {
+                    break;
+                }
+            }
+
+            if (properties.file_to_extract.empty()) {
+                std::cout << "There's no file to extract" << std::endl;
+                exit(0);
             }
         } else if (tokens.front() == "-h") {
             properties.command_type = CommandType::kHelp;
             tokens.pop();
+        } else {
+            properties.command_type = CommandType::kUnknownType;
+            break;
         }
     }
 
@@ -94,8 +164,20 @@ void PrintHelp() {
     std::cout << "Usage:" << std::endl << std::endl;
     std::cout << "archiver -c archive_name file1 [file2 ...] : "
               << "Compress files file1 [file2 ...] and save them in archive archive_name" << std::endl;
+    std::cout << "archiver -c archive_name -j N file1 [file2 ...] : "
+              << "Same as above, but compress using N threads" << std::endl;
+    std::cout << "archiver -c archive_name -i file1 [file2 ...] : "
+              << "Same as above, but store every chunk as interleaved streams that are decoded side by side" << std::endl;
     std::cout << "archiver -d archive_name : "
               << "Decompress archive archive_name and save result in current directory" << std::endl;
+    std::cout << "archiver -d archive_name -j N : "
+              << "Same as above, but decompress using N threads" << std::endl;
+    std::cout << "archiver -c - - : "
+              << "Compress standard input and write the archive to standard output" << std::endl;
+    std::cout << "archiver -d - -o - : "
+              << "Decompress single file archive from standard input and write it to standard output" << std::endl;
+    std::cout << "archiver -x archive_name file : "
+              << "Decompress only file from archive archive_name and save it in current directory" << std::endl;
     std::cout << "archiver -h"
               << " : "
               << "Print help message" << std::endl;
@@ -105,31 +187,85 @@ int main(int argc, char* argv[]) {
     CommandProperties properties = ParseArguments(argc, argv);
     Archiver archiver;
 
+    archiver.SetThreadsCount(properties.threads_count);
+    archiver.SetChunkLayout(properties.chunk_layout);
+
     if (properties.command_type == CommandType::kCompress) {
         std::vector<std::unique_ptr<ReaderInterface>> readers;
 
         try {
             for (const std::string& file : properties.files_to_compress) {
-                readers.emplace_back(std::make_unique<FileReader>(file));
+                if (file == kStandardStreamName) {
+                    readers.emplace_back(std::make_unique<StreamReader>());
+                } else {
+                    readers.emplace_back(std::make_unique<MmapReader>(file));
+                }
+            }
+
+            std::unique_ptr<WriterInterface> writer;
+
+            if (properties.archive_name == kStandardStreamName) {
+                writer = std::make_unique<StreamWriter>();
+            } else {
+                writer = std::make_unique<FileWriter>(properties.output_directory);
             }
 
-            archiver.Compress(std::move(readers), std::make_unique<FileWriter>(properties.output_directory),
-                              properties.archive_name);
+            archiver.Compress(std::move(readers), std::move(writer), properties.archive_name);
         }
 
         catch (const std::exception& e) {
-            std::cout << e.what() << std::endl;
+            std::cerr << e.what() << std::endl;
             return 0;
         }
 
     } else if (properties.command_type == CommandType::kDecompress) {
         try {
-            archiver.Decompress(std::make_unique<FileReader>(properties.archive_name),
-                                std::make_unique<FileWriter>(properties.output_directory));
+            std::unique_ptr<ReaderInterface> reader;
+            std::unique_ptr<WriterInterface> writer;
+
+            if (properties.threads_count > 1 && properties.archive_name != kStandardStreamName &&
+                properties.output_directory != kStandardStreamName) {
+                archiver.DecompressInParallel(
+                    [&properties] { return std::make_unique<FileReader>(properties.archive_name); },
+                    [&properties] { return std::make_unique<FileWriter>(properties.output_directory); });
+                return 0;
+            }
+
+            if (properties.archive_name == kStandardStreamName) {
+                reader = std::make_unique<StreamReader>();
+            } else {
+                reader = std::make_unique<FileReader>(properties.archive_name);
+            }
+
+            if (properties.output_directory == kStandardStreamName) {
+                writer = std::make_unique<StreamWriter>();
+            } else {
+                writer = std::make_unique<FileWriter>(properties.output_directory);
+            }
+
+            archiver.Decompress(std::move(reader), std::move(writer));
+        }
+
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 0;
+        }
+    } else if (properties.command_type == CommandType::kExtract) {
+        try {
+            std::unique_ptr<WriterInterface> writer;
+
+            if (properties.output_directory == kStandardStreamName) {
+                writer = std::make_unique<StreamWriter>();
+            } else {
+                writer = std::make_unique<FileWriter>(properties.output_directory);
+            }
+
+            archiver.Extract(std::make_unique<FileReader>(properties.archive_name), std::move(writer),
+                             properties.file_to_extract);
         }
 
         catch (const std::exception& e) {
-            std::cout << e.what() << std::endl;
+            std::cerr << e.what() << std::endl;
             return 0;
         }
     } else if (properties.command_type == CommandType::kHelp) {
@@ -1,11 +1,20 @@
 #pragma once
+#include <algorithm>
 #include <functional>
-#include <queue>
-
-template <class T, class Compare = std::less<T>>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Implicit d-ary heap kept in one vector allocated with Allocator. Top() is an element that no other element
+// is Compare-less than.
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
 class PriorityQueue {
 public:
-    ~PriorityQueue();
+    static const size_t kArity = 4;
+
+    PriorityQueue() = default;
+    explicit PriorityQueue(const Allocator& allocator);
 
     void Push(T value);
     void Pop();
@@ -15,130 +24,101 @@ public:
     size_t GetSize() const;
 
 private:
-    struct Node {
-        Node* left_child = nullptr;
-        Node* right_child = nullptr;
-        size_t subtree_size = 0;
-        T value;
-    };
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
 
 private:
-    Node* root_ = nullptr;
-    size_t size_ = 0;
+    std::vector<T, Allocator> heap_;
 };
 
-template <class T, class Compare>
-PriorityQueue<T, Compare>::~PriorityQueue() {
-    std::queue<Node*> to_delete;
+template <class T, class Compare, class Allocator>
+PriorityQueue<T, Compare, Allocator>::PriorityQueue(const Allocator& allocator) : heap_(allocator) {
+}
 
-    to_delete.push(root_);
+template <class T, class Compare, class Allocator>
+void PriorityQueue<T, Compare, Allocator>::Push(T value) {
+    heap_.push_back(std::move(value));
+    SiftUp(heap_.size() - 1);
+}
 
-    while (!to_delete.empty()) {
-        Node* node = to_delete.front();
-        to_delete.pop();
+template <class T, class Compare, class Allocator>
+void PriorityQueue<T, Compare, Allocator>::Pop() {
+    if (heap_.empty()) {
+        throw std::runtime_error("PriorityQueue::POP: Attempt to pop from empty queue");
+    }
 
-        if (node != nullptr) {
-            if (node->left_child != nullptr) {
-                to_delete.push(node->left_child);
-            }
+    heap_.front() = std::move(heap_.back());
+    heap_.pop_back();
 
-            if (node->right_child != nullptr) {
-                to_delete.push(node->right_child);
-            }
-        }
+    if (!heap_.empty()) {
+        SiftDown(0);
+    }
+}
 
-        delete node;
+template <class T, class Compare, class Allocator>
+const T& PriorityQueue<T, Compare, Allocator>::Top() const {
+    if (heap_.empty()) {
+        throw std::runtime_error("PRIORITY_QUEUE::TOP: This function can't be used on empty queue");
     }
+
+    return heap_.front();
 }
 
-template <class T, class Compare>
-void PriorityQueue<T, Compare>::Push(T value) {
-    Node** current_node = &root_;
+template <class T, class Compare, class Allocator>
+bool PriorityQueue<T, Compare, Allocator>::IsEmpty() const {
+    return heap_.empty();
+}
 
-    while ((*current_node) != nullptr) {
-        ++(*current_node)->subtree_size;
+template <class T, class Compare, class Allocator>
+size_t PriorityQueue<T, Compare, Allocator>::GetSize() const {
+    return heap_.size();
+}
 
-        if (Compare()(value, (*current_node)->value)) {
-            std::swap((*current_node)->value, value);
-        }
+template <class T, class Compare, class Allocator>
+void PriorityQueue<T, Compare, Allocator>::SiftUp(size_t index) {
+    T value = std::move(heap_[index]);
 
-        if ((*current_node)->left_child == nullptr) {
-            current_node = &(*current_node)->left_child;
-        } else if ((*current_node)->right_child == nullptr) {
-            current_node = &(*current_node)->right_child;
-        } else {
-            if ((*current_node)->left_child->subtree_size < (*current_node)->right_child->subtree_size) {
-                current_node = &(*current_node)->left_child;
-            } else {
-                current_node = &(*current_node)->right_child;
-            }
+    while (index > 0) {
+        size_t parent = (index - 1) / kArity;
+
+        if (!Compare()(value, heap_[parent])) {
+            break;
         }
+
+        heap_[index] = std::move(heap_[parent]);
+        index = parent;
     }
 
-    (*current_node) = new Node{.value = std::move(value)};
-    ++size_;
+    heap_[index] = std::move(value);
 }
 
-template <class T, class Compare>
-void PriorityQueue<T, Compare>::Pop() {
-    Node** current_node = &root_;
-    Node** previous_node = &root_;
+template <class T, class Compare, class Allocator>
+void PriorityQueue<T, Compare, Allocator>::SiftDown(size_t index) {
+    T value = std::move(heap_[index]);
 
-    if (size_ == 0) {
-        throw std::runtime_error("PriorityQueue::POP: Attempt to pop from empty queue");
-    }
-
-    while ((*current_node)->left_child != nullptr || (*current_node)->right_child != nullptr) {
-        previous_node = current_node;
-        --(*current_node)->subtree_size;
-
-        if ((*current_node)->left_child == nullptr) {
-            std::swap((*current_node)->value, (*current_node)->right_child->value);
-            current_node = &(*current_node)->right_child;
-        } else if ((*current_node)->right_child == nullptr) {
-            std::swap((*current_node)->value, (*current_node)->left_child->value);
-            current_node = &(*current_node)->left_child;
-        } else {
-            if (Compare()((*current_node)->right_child->value, (*current_node)->left_child->value)) {
-                std::swap((*current_node)->left_child, (*current_node)->right_child);
-            }
+    while (true) {
+        size_t first_child = index * kArity + 1;
 
-            std::swap((*current_node)->value, (*current_node)->left_child->value);
-
-            current_node = &(*current_node)->left_child;
+        if (first_child >= heap_.size()) {
+            break;
         }
-    }
-
-    if ((*previous_node)->left_child == (*current_node)) {
-        (*previous_node)->left_child = nullptr;
-    } else {
-        (*previous_node)->right_child = nullptr;
-    }
 
-    delete (*current_node);
+        size_t last_child = std::min(first_child + kArity, heap_.size());
+        size_t best_child = first_child;
 
-    --size_;
+        for (size_t child = first_child + 1; child < last_child; ++child) {
+            if (Compare()(heap_[child], heap_[best_child])) {
+                best_child = child;
+            }
+        }
 
-    if (size_ == 0) {
-        root_ = nullptr;
-    }
-}
+        if (!Compare()(heap_[best_child], value)) {
+            break;
+        }
 
-template <class T, class Compare>
-const T& PriorityQueue<T, Compare>::Top() const {
-    if (root_ == nullptr) {
-        throw std::runtime_error("PRIORITY_QUEUE::TOP: This function can't be used on empty queue");
+        heap_[index] = std::move(heap_[best_child]);
+        index = best_child;
     }
 
-    return root_->value;
-}
-
-template <class T, class Compare>
-bool PriorityQueue<T, Compare>::IsEmpty() const {
-    return size_ == 0;
+    heap_[index] = std::move(value);
 }
-
-template <class T, class Compare>
-size_t PriorityQueue<T, Compare>::GetSize() const {
-    return size_;
-}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <queue>
 #include <chrono>
 #include <random>
+#include <memory_resource>
 
 TEST(PriorityQueue, FullTest) {
     std::mt19937 random_gen(std::chrono::high_resolution_clock::now().time_since_epoch().count());
@@ -80,6 +81,33 @@ TEST(PriorityQueue, UsageTest) {
     ASSERT_EQ(queue_to_test.Top(), tester_queue.top());
 }
 
+TEST(PriorityQueue, ArenaTest) {
+    std::mt19937 random_gen(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    auto gen_number = std::bind(std::uniform_int_distribution<size_t>(0, 1'000'000), random_gen);
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<>> tester_queue;
+    PriorityQueue<size_t, std::less<>, std::pmr::polymorphic_allocator<size_t>> queue_to_test(&arena);
+
+    for (size_t i = 0; i < 100'000; ++i) {
+        size_t number = gen_number();
+
+        tester_queue.push(number);
+        queue_to_test.Push(number);
+
+        ASSERT_EQ(queue_to_test.Top(), tester_queue.top());
+    }
+
+    while (!tester_queue.empty()) {
+        ASSERT_EQ(queue_to_test.Top(), tester_queue.top());
+
+        tester_queue.pop();
+        queue_to_test.Pop();
+    }
+
+    ASSERT_TRUE(queue_to_test.IsEmpty());
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,61 @@
+#include "bit_reader.h"
+
+#include <stdexcept>
+
+BitReader::BitReader(ReaderInterface& reader) : reader_(&reader) {
+}
+
+BitReader::BitReader(std::span<const unsigned char> data) : block_(data) {
+}
+
+bool BitReader::HasBits(size_t count) {
+    if (bit_count_ < count) {
+        Refill();
+    }
+
+    return bit_count_ >= count;
+}
+
+uint64_t BitReader::PeekBits(size_t count) {
+    if (bit_count_ < count) {
+        Refill();
+    }
+
+    return Peek(count);
+}
+
+void BitReader::SkipBits(size_t count) {
+    if (bit_count_ < count && Refill() < count) {
+        throw std::runtime_error("BIT_READER::SKIP_BITS: Unexpected end of stream");
+    }
+
+    Consume(count);
+}
+
+uint64_t BitReader::ReadBits(size_t count) {
+    uint64_t bits = PeekBits(count);
+
+    SkipBits(count);
+
+    return bits;
+}
+
+void BitReader::AlignToByte() {
+    // Whole bytes are loaded into the buffer, so the bits left before the boundary are bit_count_ % 8.
+    SkipBits(bit_count_ % 8);
+}
+
+void BitReader::RefillSlow() {
+    while (bit_count_ < kMaxPeekBits) {
+        if (block_.empty()) {
+            if (reader_ == nullptr || (block_ = reader_->ReadNextBlock()).empty()) {
+                return;
+            }
+        }
+
+        // A fast refill may have loaded this byte already, it is put to the same bits again.
+        bit_buffer_ |= uint64_t(block_.front()) << (kMaxPeekBits - bit_count_);
+        bit_count_ += 8;
+        block_ = block_.subspan(1);
+    }
+}
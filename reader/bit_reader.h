@@ -0,0 +1,71 @@
+#pragma once
+#include "reader_interface.h"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// Reads bits from blocks of ReaderInterface (or from a single memory block) through a 64-bit buffer,
+// so that several bits can be peeked and skipped at once.
+// Decoding loops call Refill once and then Peek and Consume up to the returned count of bits without any checks.
+// The other methods check the count of bits themselves.
+class BitReader {
+public:
+    static constexpr size_t kMaxPeekBits = 56;
+
+    explicit BitReader(ReaderInterface& reader);
+    explicit BitReader(std::span<const unsigned char> data);
+
+    // Loads bits until at least kMaxPeekBits are buffered or the stream ends, returns the count of buffered bits.
+    size_t Refill();
+    // Returns next count (at most the buffered count) bits. Bits past the end are zeros.
+    uint64_t Peek(size_t count) const;
+    // Drops count (at most the buffered count) bits.
+    void Consume(size_t count);
+
+    bool HasBits(size_t count);
+    // Returns next count (at most kMaxPeekBits) bits without consuming them. Bits past the end are zeros.
+    uint64_t PeekBits(size_t count);
+    void SkipBits(size_t count);
+    uint64_t ReadBits(size_t count);
+    // Skips bits up to the next byte boundary of the stream.
+    void AlignToByte();
+
+private:
+    void RefillSlow();
+
+private:
+    ReaderInterface* reader_ = nullptr;
+    std::span<const unsigned char> block_;
+    uint64_t bit_buffer_ = 0;
+    size_t bit_count_ = 0;
+};
+
+inline size_t BitReader::Refill() {
+    if (block_.size() < sizeof(uint64_t)) {
+        RefillSlow();
+        return bit_count_;
+    }
+
+    // Eight bytes are loaded at once and as many whole bytes as fit are counted as consumed. The bytes that
+    // only partly fit are loaded again by the next refill, to the same bit positions, so no branch is needed.
+    uint64_t bytes;
+    std::memcpy(&bytes, block_.data(), sizeof(bytes));
+    bit_buffer_ |= __builtin_bswap64(bytes) >> bit_count_;
+
+    size_t bytes_consumed = (63 - bit_count_) / 8;
+    block_ = block_.subspan(bytes_consumed);
+    bit_count_ += bytes_consumed * 8;
+
+    return bit_count_;
+}
+
+inline uint64_t BitReader::Peek(size_t count) const {
+    // Shifting by 64 is undefined, so the buffer is shifted twice.
+    return (bit_buffer_ >> 1) >> (63 - count);
+}
+
+inline void BitReader::Consume(size_t count) {
+    bit_buffer_ <<= count;
+    bit_count_ -= count;
+}
@@ -4,7 +4,8 @@
 #include <stdexcept>
 #include <filesystem>
 
-FileReader::FileReader(const std::string& file_path) : file_(file_path, std::ios::binary | std::ios::ate) {
+FileReader::FileReader(const std::string& file_path, size_t buffer_size)
+    : file_(file_path, std::ios::binary | std::ios::ate), buffer_(std::max(buffer_size, size_t(1))) {
     if (!file_) {
         throw std::runtime_error("READER: Can't open file: " + file_path);
     }
@@ -28,34 +29,27 @@ const std::string& FileReader::GetFileName() const {
 }
 
 unsigned char FileReader::ReadNextByte() {
-    char buffer;
+    SkipUnfinishedByte();
 
-    file_.read(&buffer, 1);
-    ++bytes_read_;
-
-    if (bit_pos_ != 0) {
-        ++bytes_read_;
-        bit_pos_ = 0;
-        buffer_byte_ = 0;
+    if (buffer_pos_ == buffer_end_) {
+        FillBuffer();
     }
 
-    return buffer;
+    ++bytes_read_;
+
+    return buffer_[buffer_pos_++];
 }
 
 bool FileReader::ReadNextBit() {
-    bool bit = false;
-
-    if (bit_pos_ == 0) {
-        char buffer;
-        file_.read(&buffer, 1);
-
-        buffer_byte_ = buffer;
+    if (buffer_pos_ == buffer_end_) {
+        FillBuffer();
     }
 
-    bit = ((buffer_byte_ >> (7 - bit_pos_)) & 1);
+    bool bit = ((buffer_[buffer_pos_] >> (7 - bit_pos_)) & 1);
 
     if (bit_pos_ == 7) {
         bit_pos_ = 0;
+        ++buffer_pos_;
         ++bytes_read_;
     } else {
         ++bit_pos_;
@@ -64,9 +58,133 @@ bool FileReader::ReadNextBit() {
     return bit;
 }
 
+size_t FileReader::ReadBytes(std::span<unsigned char> bytes) {
+    SkipUnfinishedByte();
+
+    size_t bytes_to_read = std::min(bytes.size(), file_size_ - bytes_read_);
+    size_t bytes_done = 0;
+
+    while (bytes_done < bytes_to_read) {
+        size_t left = bytes_to_read - bytes_done;
+
+        if (buffer_pos_ == buffer_end_ && left >= buffer_.size()) {
+            file_.read(reinterpret_cast<char*>(bytes.data() + bytes_done), std::streamsize(left));
+            bytes_read_ += left;
+            bytes_done += left;
+            break;
+        }
+
+        if (buffer_pos_ == buffer_end_) {
+            FillBuffer();
+        }
+
+        size_t chunk = std::min(left, buffer_end_ - buffer_pos_);
+
+        std::copy_n(buffer_.begin() + buffer_pos_, chunk, bytes.begin() + bytes_done);
+        buffer_pos_ += chunk;
+        bytes_read_ += chunk;
+        bytes_done += chunk;
+    }
+
+    return bytes_to_read;
+}
+
+uint64_t FileReader::ReadBits(size_t count) {
+    if (count > 64) {
+        throw std::invalid_argument("READER::READ_BITS: Can't read more than 64 bits at once");
+    }
+
+    uint64_t bits = 0;
+
+    while (count != 0) {
+        if (!HasNextBit()) {
+            throw std::runtime_error("READER::READ_BITS: Not enough bits left in file: " + filename_);
+        }
+
+        if (buffer_pos_ == buffer_end_) {
+            FillBuffer();
+        }
+
+        size_t bits_left_in_byte = 8 - bit_pos_;
+        size_t take = std::min(count, bits_left_in_byte);
+        unsigned char byte = buffer_[buffer_pos_];
+
+        bits = (bits << take) | ((byte >> (bits_left_in_byte - take)) & ((1u << take) - 1));
+        count -= take;
+        bit_pos_ += take;
+
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++buffer_pos_;
+            ++bytes_read_;
+        }
+    }
+
+    return bits;
+}
+
+std::span<const unsigned char> FileReader::ReadNextBlock() {
+    SkipUnfinishedByte();
+
+    if (!HasNextByte()) {
+        return {};
+    }
+
+    if (buffer_pos_ == buffer_end_) {
+        FillBuffer();
+    }
+
+    std::span<const unsigned char> block(buffer_.data() + buffer_pos_, buffer_end_ - buffer_pos_);
+    bytes_read_ += block.size();
+    buffer_pos_ = buffer_end_;
+
+    return block;
+}
+
 void FileReader::Reset() {
+    file_.clear();
     file_.seekg(0);
     bytes_read_ = 0;
-    buffer_byte_ = 0;
     bit_pos_ = 0;
+    buffer_pos_ = 0;
+    buffer_end_ = 0;
+}
+
+void FileReader::Seek(size_t position) {
+    if (position > file_size_) {
+        throw std::out_of_range("READER::SEEK: Position is past the end of file: " + filename_);
+    }
+
+    file_.clear();
+    file_.seekg(std::streamoff(position));
+    bytes_read_ = position;
+    bit_pos_ = 0;
+    buffer_pos_ = 0;
+    buffer_end_ = 0;
+}
+
+size_t FileReader::GetSize() const {
+    return file_size_;
+}
+
+void FileReader::SkipUnfinishedByte() {
+    if (bit_pos_ != 0) {
+        bit_pos_ = 0;
+        ++buffer_pos_;
+        ++bytes_read_;
+    }
+}
+
+void FileReader::FillBuffer() {
+    size_t bytes_in_stream = file_size_ - bytes_read_;
+
+    if (bytes_in_stream == 0) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    size_t chunk = std::min(buffer_.size(), bytes_in_stream);
+
+    file_.read(reinterpret_cast<char*>(buffer_.data()), std::streamsize(chunk));
+    buffer_pos_ = 0;
+    buffer_end_ = chunk;
 }
@@ -3,10 +3,13 @@
 
 #include <fstream>
 #include <optional>
+#include <vector>
 
-class FileReader : public ReaderInterface {
+class FileReader final : public ReaderInterface {
 public:
-    explicit FileReader(const std::string& file_path);
+    static const size_t kDefaultBufferSize = 1 << 20;
+
+    explicit FileReader(const std::string& file_path, size_t buffer_size = kDefaultBufferSize);
     FileReader(const FileReader& o) = delete;
     FileReader& operator=(const FileReader& o) = delete;
     FileReader(FileReader&& o) = default;
@@ -18,7 +21,16 @@ public:
 
     unsigned char ReadNextByte() override;
     bool ReadNextBit() override;
+    size_t ReadBytes(std::span<unsigned char> bytes) override;
+    uint64_t ReadBits(size_t count) override;
+    std::span<const unsigned char> ReadNextBlock() override;
     void Reset() override;
+    void Seek(size_t position) override;
+    size_t GetSize() const override;
+
+private:
+    void SkipUnfinishedByte();
+    void FillBuffer();
 
 private:
     std::ifstream file_;
@@ -26,5 +38,7 @@ private:
     size_t file_size_ = 0;
     size_t bytes_read_ = 0;
     size_t bit_pos_ = 0;
-    unsigned char buffer_byte_ = 0;
+    std::vector<unsigned char> buffer_;
+    size_t buffer_pos_ = 0;
+    size_t buffer_end_ = 0;
 };
@@ -0,0 +1,129 @@
+#include "memory_reader.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+MemoryReader::MemoryReader(std::span<const unsigned char> data, std::string file_name)
+    : filename_(std::move(file_name)), data_(data) {
+}
+
+bool MemoryReader::HasNextByte() const {
+    return bytes_read_ < data_.size();
+}
+
+bool MemoryReader::HasNextBit() const {
+    return bytes_read_ < data_.size();
+}
+
+const std::string& MemoryReader::GetFileName() const {
+    return filename_;
+}
+
+unsigned char MemoryReader::ReadNextByte() {
+    SkipUnfinishedByte();
+
+    if (bytes_read_ == data_.size()) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    return data_[bytes_read_++];
+}
+
+bool MemoryReader::ReadNextBit() {
+    if (bytes_read_ == data_.size()) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    bool bit = ((data_[bytes_read_] >> (7 - bit_pos_)) & 1);
+
+    if (bit_pos_ == 7) {
+        bit_pos_ = 0;
+        ++bytes_read_;
+    } else {
+        ++bit_pos_;
+    }
+
+    return bit;
+}
+
+size_t MemoryReader::ReadBytes(std::span<unsigned char> bytes) {
+    SkipUnfinishedByte();
+
+    size_t bytes_to_read = std::min(bytes.size(), data_.size() - bytes_read_);
+
+    std::copy_n(data_.begin() + bytes_read_, bytes_to_read, bytes.begin());
+    bytes_read_ += bytes_to_read;
+
+    return bytes_to_read;
+}
+
+uint64_t MemoryReader::ReadBits(size_t count) {
+    if (count > 64) {
+        throw std::invalid_argument("READER::READ_BITS: Can't read more than 64 bits at once");
+    }
+
+    uint64_t bits = 0;
+
+    while (count != 0) {
+        if (!HasNextBit()) {
+            throw std::runtime_error("READER::READ_BITS: Not enough bits left in file: " + filename_);
+        }
+
+        size_t bits_left_in_byte = 8 - bit_pos_;
+        size_t take = std::min(count, bits_left_in_byte);
+
+        bits = (bits << take) | ((data_[bytes_read_] >> (bits_left_in_byte - take)) & ((1u << take) - 1));
+        count -= take;
+        bit_pos_ += take;
+
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++bytes_read_;
+        }
+    }
+
+    return bits;
+}
+
+std::span<const unsigned char> MemoryReader::ReadNextBlock() {
+    SkipUnfinishedByte();
+
+    auto block = data_.subspan(bytes_read_);
+    bytes_read_ = data_.size();
+
+    return block;
+}
+
+void MemoryReader::Reset() {
+    bytes_read_ = 0;
+    bit_pos_ = 0;
+}
+
+void MemoryReader::Seek(size_t position) {
+    if (position > data_.size()) {
+        throw std::out_of_range("READER::SEEK: Position is past the end of file: " + filename_);
+    }
+
+    bytes_read_ = position;
+    bit_pos_ = 0;
+}
+
+size_t MemoryReader::GetSize() const {
+    return data_.size();
+}
+
+std::span<const unsigned char> MemoryReader::GetResidentData() const {
+    return GetData();
+}
+
+std::span<const unsigned char> MemoryReader::GetData() const {
+    return data_;
+}
+
+void MemoryReader::SkipUnfinishedByte() {
+    if (bit_pos_ != 0) {
+        bit_pos_ = 0;
+        ++bytes_read_;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "reader_interface.h"
+
+// Reads from bytes owned by the caller, which must outlive the reader. Nothing is copied: ReadNextBlock returns
+// the rest of the bytes at once.
+class MemoryReader final : public ReaderInterface {
+public:
+    MemoryReader(std::span<const unsigned char> data, std::string file_name);
+
+    bool HasNextByte() const override;
+    bool HasNextBit() const override;
+    const std::string& GetFileName() const override;
+
+    unsigned char ReadNextByte() override;
+    bool ReadNextBit() override;
+    size_t ReadBytes(std::span<unsigned char> bytes) override;
+    uint64_t ReadBits(size_t count) override;
+    std::span<const unsigned char> ReadNextBlock() override;
+    void Reset() override;
+    void Seek(size_t position) override;
+    size_t GetSize() const override;
+    std::span<const unsigned char> GetResidentData() const override;
+
+    std::span<const unsigned char> GetData() const;
+
+private:
+    void SkipUnfinishedByte();
+
+private:
+    std::string filename_;
+    std::span<const unsigned char> data_;
+    size_t bytes_read_ = 0;
+    size_t bit_pos_ = 0;
+};
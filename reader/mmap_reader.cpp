@@ -0,0 +1,188 @@
+#include "mmap_reader.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MmapReader::MmapReader(const std::string& file_path) {
+    int fd = open(file_path.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        throw std::runtime_error("READER: Can't open file: " + file_path);
+    }
+
+    struct stat file_stat {};
+
+    if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode)) {
+        close(fd);
+        throw std::runtime_error("READER: Can't map file: " + file_path);
+    }
+
+    file_size_ = file_stat.st_size;
+
+    if (file_size_ != 0) {
+        void* mapping = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("READER: Can't map file: " + file_path);
+        }
+
+        madvise(mapping, file_size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const unsigned char*>(mapping);
+    }
+
+    close(fd);
+
+    filename_ = std::filesystem::path(file_path).filename();
+}
+
+MmapReader::MmapReader(MmapReader&& o) noexcept
+    : filename_(std::move(o.filename_)),
+      data_(std::exchange(o.data_, nullptr)),
+      file_size_(std::exchange(o.file_size_, 0)),
+      bytes_read_(std::exchange(o.bytes_read_, 0)),
+      bit_pos_(std::exchange(o.bit_pos_, 0)) {
+}
+
+MmapReader& MmapReader::operator=(MmapReader&& o) noexcept {
+    std::swap(filename_, o.filename_);
+    std::swap(data_, o.data_);
+    std::swap(file_size_, o.file_size_);
+    std::swap(bytes_read_, o.bytes_read_);
+    std::swap(bit_pos_, o.bit_pos_);
+
+    return *this;
+}
+
+MmapReader::~MmapReader() {
+    if (data_ != nullptr) {
+        munmap(const_cast<unsigned char*>(data_), file_size_);
+    }
+}
+
+bool MmapReader::HasNextByte() const {
+    return bytes_read_ < file_size_;
+}
+
+bool MmapReader::HasNextBit() const {
+    return bytes_read_ < file_size_;
+}
+
+const std::string& MmapReader::GetFileName() const {
+    return filename_;
+}
+
+unsigned char MmapReader::ReadNextByte() {
+    SkipUnfinishedByte();
+
+    if (bytes_read_ == file_size_) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    return data_[bytes_read_++];
+}
+
+bool MmapReader::ReadNextBit() {
+    if (bytes_read_ == file_size_) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    bool bit = ((data_[bytes_read_] >> (7 - bit_pos_)) & 1);
+
+    if (bit_pos_ == 7) {
+        bit_pos_ = 0;
+        ++bytes_read_;
+    } else {
+        ++bit_pos_;
+    }
+
+    return bit;
+}
+
+size_t MmapReader::ReadBytes(std::span<unsigned char> bytes) {
+    SkipUnfinishedByte();
+
+    size_t bytes_to_read = std::min(bytes.size(), file_size_ - bytes_read_);
+
+    std::copy_n(data_ + bytes_read_, bytes_to_read, bytes.begin());
+    bytes_read_ += bytes_to_read;
+
+    return bytes_to_read;
+}
+
+uint64_t MmapReader::ReadBits(size_t count) {
+    if (count > 64) {
+        throw std::invalid_argument("READER::READ_BITS: Can't read more than 64 bits at once");
+    }
+
+    uint64_t bits = 0;
+
+    while (count != 0) {
+        if (!HasNextBit()) {
+            throw std::runtime_error("READER::READ_BITS: Not enough bits left in file: " + filename_);
+        }
+
+        size_t bits_left_in_byte = 8 - bit_pos_;
+        size_t take = std::min(count, bits_left_in_byte);
+
+        bits = (bits << take) | ((data_[bytes_read_] >> (bits_left_in_byte - take)) & ((1u << take) - 1));
+        count -= take;
+        bit_pos_ += take;
+
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++bytes_read_;
+        }
+    }
+
+    return bits;
+}
+
+std::span<const unsigned char> MmapReader::ReadNextBlock() {
+    SkipUnfinishedByte();
+
+    std::span<const unsigned char> block(data_ + bytes_read_, file_size_ - bytes_read_);
+    bytes_read_ = file_size_;
+
+    return block;
+}
+
+void MmapReader::Reset() {
+    bytes_read_ = 0;
+    bit_pos_ = 0;
+}
+
+void MmapReader::Seek(size_t position) {
+    if (position > file_size_) {
+        throw std::out_of_range("READER::SEEK: Position is past the end of file: " + filename_);
+    }
+
+    bytes_read_ = position;
+    bit_pos_ = 0;
+}
+
+size_t MmapReader::GetSize() const {
+    return file_size_;
+}
+
+std::span<const unsigned char> MmapReader::GetResidentData() const {
+    return GetData();
+}
+
+std::span<const unsigned char> MmapReader::GetData() const {
+    return {data_, file_size_};
+}
+
+void MmapReader::SkipUnfinishedByte() {
+    if (bit_pos_ != 0) {
+        bit_pos_ = 0;
+        ++bytes_read_;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "reader_interface.h"
+
+class MmapReader final : public ReaderInterface {
+public:
+    explicit MmapReader(const std::string& file_path);
+    MmapReader(const MmapReader& o) = delete;
+    MmapReader& operator=(const MmapReader& o) = delete;
+    MmapReader(MmapReader&& o) noexcept;
+    MmapReader& operator=(MmapReader&& o) noexcept;
+    ~MmapReader() override;
+
+    bool HasNextByte() const override;
+    bool HasNextBit() const override;
+    const std::string& GetFileName() const override;
+
+    unsigned char ReadNextByte() override;
+    bool ReadNextBit() override;
+    size_t ReadBytes(std::span<unsigned char> bytes) override;
+    uint64_t ReadBits(size_t count) override;
+    std::span<const unsigned char> ReadNextBlock() override;
+    void Reset() override;
+    void Seek(size_t position) override;
+    size_t GetSize() const override;
+    std::span<const unsigned char> GetResidentData() const override;
+
+    std::span<const unsigned char> GetData() const;
+
+private:
+    void SkipUnfinishedByte();
+
+private:
+    std::string filename_;
+    const unsigned char* data_ = nullptr;
+    size_t file_size_ = 0;
+    size_t bytes_read_ = 0;
+    size_t bit_pos_ = 0;
+};
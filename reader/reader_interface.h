@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <span>
 #include <string>
 
 class ReaderInterface {
@@ -11,5 +13,18 @@ public:
 
     virtual unsigned char ReadNextByte() = 0;
     virtual bool ReadNextBit() = 0;
+    // Reads up to bytes.size() bytes and returns how many were read. Unfinished byte is skipped as in ReadNextByte.
+    virtual size_t ReadBytes(std::span<unsigned char> bytes) = 0;
+    // Reads count (at most 64) bits, the first read bit becomes the most significant one.
+    virtual uint64_t ReadBits(size_t count) = 0;
+    // Returns a view of the next bytes, valid until the next call to the reader. Empty view means end of file.
+    virtual std::span<const unsigned char> ReadNextBlock() = 0;
     virtual void Reset() = 0;
+    // Moves to the byte at position, so that the next read starts from it.
+    virtual void Seek(size_t position) = 0;
+    virtual size_t GetSize() const = 0;
+    // Returns all bytes of the file if they stay in memory as long as the reader lives, otherwise an empty view.
+    virtual std::span<const unsigned char> GetResidentData() const {
+        return {};
+    }
 };
@@ -0,0 +1,146 @@
+#include "stream_reader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+StreamReader::StreamReader(int fd, std::string file_name, size_t buffer_size)
+    : fd_(fd), filename_(std::move(file_name)), buffer_(std::max(buffer_size, size_t(1))) {
+}
+
+bool StreamReader::HasNextByte() const {
+    return FillBuffer();
+}
+
+bool StreamReader::HasNextBit() const {
+    return FillBuffer();
+}
+
+const std::string& StreamReader::GetFileName() const {
+    return filename_;
+}
+
+unsigned char StreamReader::ReadNextByte() {
+    SkipUnfinishedByte();
+
+    if (!FillBuffer()) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    return buffer_[buffer_pos_++];
+}
+
+bool StreamReader::ReadNextBit() {
+    if (!FillBuffer()) {
+        throw std::runtime_error("READER: Attempt to read past the end of file: " + filename_);
+    }
+
+    bool bit = ((buffer_[buffer_pos_] >> (7 - bit_pos_)) & 1);
+
+    if (bit_pos_ == 7) {
+        bit_pos_ = 0;
+        ++buffer_pos_;
+    } else {
+        ++bit_pos_;
+    }
+
+    return bit;
+}
+
+size_t StreamReader::ReadBytes(std::span<unsigned char> bytes) {
+    SkipUnfinishedByte();
+
+    size_t bytes_done = 0;
+
+    while (bytes_done < bytes.size() && FillBuffer()) {
+        size_t chunk = std::min(bytes.size() - bytes_done, buffer_end_ - buffer_pos_);
+
+        std::copy_n(buffer_.begin() + buffer_pos_, chunk, bytes.begin() + bytes_done);
+        buffer_pos_ += chunk;
+        bytes_done += chunk;
+    }
+
+    return bytes_done;
+}
+
+uint64_t StreamReader::ReadBits(size_t count) {
+    if (count > 64) {
+        throw std::invalid_argument("READER::READ_BITS: Can't read more than 64 bits at once");
+    }
+
+    uint64_t bits = 0;
+
+    while (count != 0) {
+        if (!FillBuffer()) {
+            throw std::runtime_error("READER::READ_BITS: Not enough bits left in file: " + filename_);
+        }
+
+        size_t bits_left_in_byte = 8 - bit_pos_;
+        size_t take = std::min(count, bits_left_in_byte);
+        unsigned char byte = buffer_[buffer_pos_];
+
+        bits = (bits << take) | ((byte >> (bits_left_in_byte - take)) & ((1u << take) - 1));
+        count -= take;
+        bit_pos_ += take;
+
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++buffer_pos_;
+        }
+    }
+
+    return bits;
+}
+
+std::span<const unsigned char> StreamReader::ReadNextBlock() {
+    SkipUnfinishedByte();
+
+    if (!FillBuffer()) {
+        return {};
+    }
+
+    std::span<const unsigned char> block(buffer_.data() + buffer_pos_, buffer_end_ - buffer_pos_);
+    buffer_pos_ = buffer_end_;
+
+    return block;
+}
+
+void StreamReader::Reset() {
+    throw std::runtime_error("READER::RESET: Can't reset stream: " + filename_);
+}
+
+void StreamReader::Seek(size_t) {
+    throw std::runtime_error("READER::SEEK: Can't seek in stream: " + filename_);
+}
+
+size_t StreamReader::GetSize() const {
+    throw std::runtime_error("READER::GET_SIZE: Size of stream is unknown: " + filename_);
+}
+
+void StreamReader::SkipUnfinishedByte() {
+    if (bit_pos_ != 0) {
+        bit_pos_ = 0;
+        ++buffer_pos_;
+    }
+}
+
+bool StreamReader::FillBuffer() const {
+    while (buffer_pos_ == buffer_end_ && !is_eof_) {
+        ssize_t bytes_read = read(fd_, buffer_.data(), buffer_.size());
+
+        if (bytes_read == -1 && errno == EINTR) {
+            continue;
+        }
+
+        if (bytes_read == -1) {
+            throw std::runtime_error("READER: Can't read stream: " + filename_);
+        }
+
+        buffer_pos_ = 0;
+        buffer_end_ = bytes_read;
+        is_eof_ = (bytes_read == 0);
+    }
+
+    return buffer_pos_ != buffer_end_;
+}
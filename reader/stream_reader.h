@@ -0,0 +1,49 @@
+#pragma once
+#include "reader_interface.h"
+
+#include <vector>
+
+#include <unistd.h>
+
+// Reads a non-seekable stream (standard input by default) through a buffer of a fixed size.
+// The end of the stream is detected by reading ahead, so HasNextByte may block until data arrives.
+class StreamReader final : public ReaderInterface {
+public:
+    static const size_t kDefaultBufferSize = 1 << 20;
+
+    explicit StreamReader(int fd = STDIN_FILENO, std::string file_name = "stdin",
+                          size_t buffer_size = kDefaultBufferSize);
+    StreamReader(const StreamReader& o) = delete;
+    StreamReader& operator=(const StreamReader& o) = delete;
+    StreamReader(StreamReader&& o) = default;
+    StreamReader& operator=(StreamReader&& o) = default;
+
+    bool HasNextByte() const override;
+    bool HasNextBit() const override;
+    const std::string& GetFileName() const override;
+
+    unsigned char ReadNextByte() override;
+    bool ReadNextBit() override;
+    size_t ReadBytes(std::span<unsigned char> bytes) override;
+    uint64_t ReadBits(size_t count) override;
+    std::span<const unsigned char> ReadNextBlock() override;
+    // Streams can't be read twice or skipped around, so these always throw.
+    void Reset() override;
+    void Seek(size_t position) override;
+    size_t GetSize() const override;
+
+private:
+    void SkipUnfinishedByte();
+    // Reads more data if the buffer is exhausted, returns false at the end of the stream.
+    bool FillBuffer() const;
+
+private:
+    int fd_ = STDIN_FILENO;
+    std::string filename_;
+    size_t bit_pos_ = 0;
+    // Filling the buffer doesn't change what the reader returns, so it is allowed in const methods.
+    mutable std::vector<unsigned char> buffer_;
+    mutable size_t buffer_pos_ = 0;
+    mutable size_t buffer_end_ = 0;
+    mutable bool is_eof_ = false;
+};
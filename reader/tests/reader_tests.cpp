@@ -1,10 +1,20 @@
 #include "reader/file_reader.h"
+#include "reader/mmap_reader.h"
+#include "reader/memory_reader.h"
+#include "reader/stream_reader.h"
+#include "reader/bit_reader.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
+#include <random>
 #include <vector>
 
+#include <fcntl.h>
+
+template <class Reader = FileReader>
 void TestByteReading(const std::string& file_path, const std::vector<unsigned char>& expected_data) {
-    FileReader reader(file_path);
+    Reader reader(file_path);
 
     for (size_t i = 0; i < 4; ++i) {
         for (auto byte : expected_data) {
@@ -18,8 +28,9 @@ void TestByteReading(const std::string& file_path, const std::vector<unsigned ch
     }
 }
 
+template <class Reader = FileReader>
 void TestBitReading(const std::string& file_path, const std::vector<unsigned char>& expected_data) {
-    FileReader reader(file_path);
+    Reader reader(file_path);
 
     for (size_t i = 0; i < 4; ++i) {
         for (auto byte : expected_data) {
@@ -35,12 +46,48 @@ void TestBitReading(const std::string& file_path, const std::vector<unsigned cha
     }
 }
 
+void TestBulkReading(const std::string& file_path, const std::vector<unsigned char>& expected_data) {
+    for (size_t buffer_size : {1, 3, 5, 1 << 20}) {
+        FileReader reader(file_path, buffer_size);
+
+        std::vector<unsigned char> bytes(expected_data.size() + 1);
+        ASSERT_EQ(reader.ReadBytes(bytes), expected_data.size());
+        bytes.pop_back();
+        ASSERT_EQ(bytes, expected_data);
+        ASSERT_FALSE(reader.HasNextByte());
+
+        reader.Reset();
+
+        for (size_t i = 0; i < expected_data.size(); i += 2) {
+            ASSERT_EQ(reader.ReadBits(4), expected_data[i] >> 4);
+            ASSERT_EQ(reader.ReadBits(12), ((expected_data[i] & 0xF) << 8) | expected_data[i + 1]);
+        }
+
+        ASSERT_FALSE(reader.HasNextBit());
+
+        reader.Reset();
+        reader.ReadNextBit();
+
+        std::vector<unsigned char> tail(expected_data.size() - 1);
+        ASSERT_EQ(reader.ReadBytes(tail), tail.size());
+        ASSERT_TRUE(std::equal(tail.begin(), tail.end(), expected_data.begin() + 1));
+
+        ASSERT_EQ(reader.GetSize(), expected_data.size());
+        reader.Seek(5);
+        ASSERT_EQ(reader.ReadNextByte(), expected_data[5]);
+        reader.Seek(expected_data.size());
+        ASSERT_FALSE(reader.HasNextByte());
+        ASSERT_THROW(reader.Seek(expected_data.size() + 1), std::out_of_range);
+    }
+}
+
 TEST(Reader, ReadBinaryFile1) {
     const std::vector<unsigned char> expected_data = {0xAA, 0xAA, 0xAA, 0xAA, 0xBB, 0xBB,
                                                       0xBB, 0xBB, 0xCC, 0xCC, 0xCC, 0xCC};
 
     TestByteReading("mock/test_1.bin", expected_data);
     TestBitReading("mock/test_1.bin", expected_data);
+    TestBulkReading("mock/test_1.bin", expected_data);
 }
 
 TEST(Reader, ReadBinaryFile2) {
@@ -49,6 +96,187 @@ TEST(Reader, ReadBinaryFile2) {
 
     TestByteReading("mock/test_2.bin", expected_data);
     TestBitReading("mock/test_2.bin", expected_data);
+    TestBulkReading("mock/test_2.bin", expected_data);
+}
+
+void TestBlockReading(ReaderInterface& reader, const std::vector<unsigned char>& expected_data) {
+    std::vector<unsigned char> data;
+
+    for (auto block = reader.ReadNextBlock(); !block.empty(); block = reader.ReadNextBlock()) {
+        data.insert(data.end(), block.begin(), block.end());
+    }
+
+    ASSERT_EQ(data, expected_data);
+    ASSERT_FALSE(reader.HasNextByte());
+}
+
+TEST(Reader, ReadMappedFile) {
+    const std::vector<unsigned char> expected_data = {0xFF, 0xAF, 0xFA, 0xF1, 0xF2, 0xF4, 0xF5,
+                                                      0xF6, 0xBC, 0xDD, 0x30, 0x00, 0x40, 0xFF};
+
+    TestByteReading<MmapReader>("mock/test_2.bin", expected_data);
+    TestBitReading<MmapReader>("mock/test_2.bin", expected_data);
+
+    MmapReader reader("mock/test_2.bin");
+
+    ASSERT_EQ(reader.GetFileName(), "test_2.bin");
+    ASSERT_TRUE(std::equal(expected_data.begin(), expected_data.end(), reader.GetData().begin()));
+    ASSERT_EQ(reader.ReadBits(12), 0xFFA);
+
+    std::vector<unsigned char> bytes(4);
+    ASSERT_EQ(reader.ReadBytes(bytes), 4);
+    ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), expected_data.begin() + 2));
+
+    reader.Seek(9);
+    ASSERT_EQ(reader.ReadNextByte(), expected_data[9]);
+
+    reader.Reset();
+    TestBlockReading(reader, expected_data);
+}
+
+TEST(Reader, ReadMemory) {
+    const std::vector<unsigned char> expected_data = {0xFF, 0xAF, 0xFA, 0xF1, 0xF2, 0xF4, 0xF5,
+                                                      0xF6, 0xBC, 0xDD, 0x30, 0x00, 0x40, 0xFF};
+
+    MemoryReader reader(expected_data, "memory");
+
+    ASSERT_EQ(reader.GetFileName(), "memory");
+    ASSERT_EQ(reader.GetResidentData().data(), expected_data.data());
+    ASSERT_EQ(reader.ReadBits(12), 0xFFA);
+
+    std::vector<unsigned char> bytes(4);
+    ASSERT_EQ(reader.ReadBytes(bytes), 4);
+    ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), expected_data.begin() + 2));
+    ASSERT_EQ(reader.ReadNextByte(), 0xF5);
+    ASSERT_TRUE(reader.ReadNextBit());
+
+    auto block = reader.ReadNextBlock();
+    ASSERT_EQ(block.data(), expected_data.data() + 8);
+    ASSERT_EQ(block.size(), expected_data.size() - 8);
+    ASSERT_TRUE(reader.ReadNextBlock().empty());
+    ASSERT_THROW(reader.ReadNextByte(), std::runtime_error);
+
+    reader.Seek(9);
+    ASSERT_EQ(reader.ReadNextByte(), expected_data[9]);
+    ASSERT_THROW(reader.Seek(expected_data.size() + 1), std::out_of_range);
+
+    reader.Reset();
+    TestBlockReading(reader, expected_data);
+}
+
+TEST(Reader, ReadBlocks) {
+    const std::vector<unsigned char> expected_data = {0xAA, 0xAA, 0xAA, 0xAA, 0xBB, 0xBB,
+                                                      0xBB, 0xBB, 0xCC, 0xCC, 0xCC, 0xCC};
+
+    for (size_t buffer_size : {1, 5, 1 << 20}) {
+        FileReader reader("mock/test_1.bin", buffer_size);
+        TestBlockReading(reader, expected_data);
+    }
+}
+
+TEST(Reader, ReadStream) {
+    const std::vector<unsigned char> expected_data = {0xFF, 0xAF, 0xFA, 0xF1, 0xF2, 0xF4, 0xF5,
+                                                      0xF6, 0xBC, 0xDD, 0x30, 0x00, 0x40, 0xFF};
+
+    for (size_t buffer_size : {1, 3, 14, 1 << 20}) {
+        int fd = open("mock/test_2.bin", O_RDONLY);
+        ASSERT_NE(fd, -1);
+
+        StreamReader reader(fd, "test_2.bin", buffer_size);
+
+        ASSERT_EQ(reader.GetFileName(), "test_2.bin");
+        ASSERT_EQ(reader.ReadBits(12), 0xFFA);
+
+        std::vector<unsigned char> bytes(4);
+        ASSERT_EQ(reader.ReadBytes(bytes), 4);
+        ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), expected_data.begin() + 2));
+        ASSERT_EQ(reader.ReadNextByte(), 0xF5);
+        ASSERT_TRUE(reader.ReadNextBit());
+
+        std::vector<unsigned char> tail(expected_data.begin() + 8, expected_data.end());
+        TestBlockReading(reader, tail);
+        ASSERT_THROW(reader.ReadNextByte(), std::runtime_error);
+        ASSERT_THROW(reader.Reset(), std::runtime_error);
+
+        close(fd);
+    }
+}
+
+TEST(Reader, BitReaderTest) {
+    const std::vector<unsigned char> expected_data = {0xFF, 0xAF, 0xFA, 0xF1, 0xF2, 0xF4, 0xF5,
+                                                      0xF6, 0xBC, 0xDD, 0x30, 0x00, 0x40, 0xFF};
+
+    FileReader file_reader("mock/test_2.bin", 3);
+    BitReader reader(file_reader);
+    BitReader memory_reader(expected_data);
+
+    for (BitReader* bit_reader : {&reader, &memory_reader}) {
+        ASSERT_EQ(bit_reader->PeekBits(12), 0xFFA);
+        ASSERT_EQ(bit_reader->ReadBits(4), 0xF);
+        ASSERT_EQ(bit_reader->ReadBits(40), 0xFAFFAF1F2F);
+        bit_reader->SkipBits(8);
+        ASSERT_EQ(bit_reader->ReadBits(56), 0x5F6BCDD300040F);
+
+        ASSERT_TRUE(bit_reader->HasBits(4));
+        ASSERT_FALSE(bit_reader->HasBits(5));
+        ASSERT_EQ(bit_reader->PeekBits(8), 0xF0);
+        ASSERT_EQ(bit_reader->ReadBits(4), 0xF);
+        ASSERT_THROW(bit_reader->SkipBits(1), std::runtime_error);
+    }
+}
+
+TEST(Reader, BitReaderRefillTest) {
+    std::mt19937 generator(7);
+    std::vector<unsigned char> data(1000);
+
+    for (unsigned char& byte : data) {
+        byte = generator() % 256;
+    }
+
+    std::ofstream("mock/random.bin", std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    FileReader file_reader("mock/random.bin", 7);
+    BitReader reader(file_reader);
+    BitReader memory_reader(data);
+
+    for (BitReader* bit_reader : {&reader, &memory_reader}) {
+        size_t position = 0;
+
+        while (position < data.size() * 8) {
+            size_t available = bit_reader->Refill();
+            size_t count = std::min<size_t>(generator() % 16, available);
+
+            ASSERT_LE(available, data.size() * 8 - position);
+            ASSERT_GE(available, std::min<size_t>(BitReader::kMaxPeekBits, data.size() * 8 - position));
+
+            uint64_t expected = 0;
+
+            for (size_t i = position; i < position + count; ++i) {
+                expected = (expected << 1) | ((data[i / 8] >> (7 - i % 8)) & 1);
+            }
+
+            ASSERT_EQ(bit_reader->Peek(count), expected);
+            bit_reader->Consume(count);
+            position += count;
+        }
+
+        ASSERT_EQ(bit_reader->Refill(), 0);
+        ASSERT_EQ(bit_reader->PeekBits(8), 0);
+    }
+}
+
+TEST(Reader, BitReaderAlignTest) {
+    const std::vector<unsigned char> data = {0xFF, 0xAF, 0xFA, 0xF1};
+    BitReader reader(data);
+
+    reader.AlignToByte();
+    ASSERT_EQ(reader.ReadBits(3), 0x7);
+    reader.AlignToByte();
+    ASSERT_EQ(reader.ReadBits(8), 0xAF);
+    reader.AlignToByte();
+    ASSERT_EQ(reader.ReadBits(12), 0xFAF);
+    reader.AlignToByte();
+    ASSERT_FALSE(reader.HasBits(1));
 }
 
 TEST(Reader, NameGettingTest) {
@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Bounded queue between exactly one producer thread and one consumer thread. TryPush and TryPop never lock
+// or wait. Push and Pop wait for room or for a value, sleeping on a counter of ring events instead of spinning.
+// After Close both sides wake up for good: Push fails and Pop fails once the ring is empty.
+template <class T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity);
+    SpscRing(const SpscRing& o) = delete;
+    SpscRing& operator=(const SpscRing& o) = delete;
+
+    // Moves value into the ring if there is room, otherwise leaves it as is.
+    bool TryPush(T& value);
+    bool TryPop(T& value);
+    bool Push(T value);
+    bool Pop(T& value);
+    void Close();
+
+private:
+    void NotifyEvent();
+
+private:
+    static const size_t kCacheLineSize = 64;
+
+    std::vector<T> slots_;
+    // Both counters only grow, the slot of a counter is its value modulo the capacity.
+    alignas(kCacheLineSize) std::atomic<size_t> head_ = 0;
+    alignas(kCacheLineSize) std::atomic<size_t> tail_ = 0;
+    alignas(kCacheLineSize) std::atomic<uint32_t> events_ = 0;
+    std::atomic<bool> is_closed_ = false;
+};
+
+template <class T>
+SpscRing<T>::SpscRing(size_t capacity) : slots_(capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("SPSC_RING: Capacity must be positive");
+    }
+}
+
+template <class T>
+bool SpscRing<T>::TryPush(T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+        return false;
+    }
+
+    slots_[tail % slots_.size()] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    NotifyEvent();
+
+    return true;
+}
+
+template <class T>
+bool SpscRing<T>::TryPop(T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+
+    if (head == tail_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    value = std::move(slots_[head % slots_.size()]);
+    head_.store(head + 1, std::memory_order_release);
+    NotifyEvent();
+
+    return true;
+}
+
+template <class T>
+bool SpscRing<T>::Push(T value) {
+    while (true) {
+        // The counter is read before trying, so an event between the try and the wait is never missed.
+        uint32_t events = events_.load(std::memory_order_acquire);
+
+        if (is_closed_) {
+            return false;
+        }
+
+        if (TryPush(value)) {
+            return true;
+        }
+
+        events_.wait(events, std::memory_order_acquire);
+    }
+}
+
+template <class T>
+bool SpscRing<T>::Pop(T& value) {
+    while (true) {
+        uint32_t events = events_.load(std::memory_order_acquire);
+
+        if (TryPop(value)) {
+            return true;
+        }
+
+        if (is_closed_) {
+            return false;
+        }
+
+        events_.wait(events, std::memory_order_acquire);
+    }
+}
+
+template <class T>
+void SpscRing<T>::Close() {
+    is_closed_ = true;
+    NotifyEvent();
+}
+
+template <class T>
+void SpscRing<T>::NotifyEvent() {
+    events_.fetch_add(1, std::memory_order_release);
+    events_.notify_all();
+}
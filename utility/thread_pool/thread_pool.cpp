@@ -0,0 +1,125 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace {
+thread_local const void* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads_count) {
+    for (size_t i = 0; i < std::max(threads_count, size_t(1)); ++i) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stopping_ = true;
+    }
+
+    has_task_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged_task(std::move(task));
+    std::future<void> result = packaged_task.get_future();
+    size_t worker = GetCurrentWorker();
+    TaskQueue& queue = *queues_[worker != kNoWorker ? worker : next_queue_++ % queues_.size()];
+
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(packaged_task));
+    }
+
+    {
+        std::lock_guard lock(sleep_mutex_);
+        ++queued_tasks_;
+    }
+
+    has_task_.notify_one();
+
+    return result;
+}
+
+void ThreadPool::Wait(const std::future<void>& result) {
+    size_t worker = GetCurrentWorker();
+
+    if (worker == kNoWorker) {
+        result.wait();
+        return;
+    }
+
+    while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        // Only own tasks are run here: a stolen task may be long, e.g. another whole file, and would delay
+        // the task that waits.
+        if (!TryRunTask(worker, false)) {
+            result.wait_for(kWaitPollInterval);
+        }
+    }
+}
+
+bool ThreadPool::TryRunTask(size_t worker_index, bool may_steal) {
+    std::packaged_task<void()> task;
+
+    // The newest task of the own queue is likely the one this worker waits for and its data is still in cache.
+    if (worker_index != kNoWorker) {
+        TaskQueue& queue = *queues_[worker_index];
+        std::lock_guard lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    for (size_t i = 1; may_steal && !task.valid() && i <= queues_.size(); ++i) {
+        TaskQueue& queue = *queues_[(worker_index + i) % queues_.size()];
+        std::lock_guard lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task.valid()) {
+        return false;
+    }
+
+    --queued_tasks_;
+    task();
+
+    return true;
+}
+
+size_t ThreadPool::GetCurrentWorker() const {
+    return (current_pool == this ? current_worker : kNoWorker);
+}
+
+void ThreadPool::WorkerLoop(size_t worker_index) {
+    current_pool = this;
+    current_worker = worker_index;
+
+    while (true) {
+        if (TryRunTask(worker_index, true)) {
+            continue;
+        }
+
+        std::unique_lock lock(sleep_mutex_);
+        has_task_.wait(lock, [this] { return stopping_ || queued_tasks_ > 0; });
+
+        if (stopping_) {
+            return;
+        }
+    }
+}
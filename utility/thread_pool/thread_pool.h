@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: every worker has its own queue of tasks. A task submitted by a worker goes to the back of
+// that worker's queue and is taken from there first, tasks submitted from other threads are spread over the
+// queues. A worker with an empty queue steals the oldest task of another queue, so big jobs split into small
+// tasks keep all workers busy until the end.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads_count);
+    ThreadPool(const ThreadPool& o) = delete;
+    ThreadPool& operator=(const ThreadPool& o) = delete;
+    ~ThreadPool();
+
+    // Exceptions thrown by the task are rethrown from the returned future.
+    std::future<void> Submit(std::function<void()> task);
+    // Waits until result is ready. Called from a worker, runs tasks of its own queue meanwhile, so a task may
+    // wait for the tasks it has submitted without holding a worker idle.
+    void Wait(const std::future<void>& result);
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::packaged_task<void()>> tasks;
+    };
+
+    static const size_t kNoWorker = static_cast<size_t>(-1);
+    // A waiting worker with nothing to run looks for new tasks this often.
+    static constexpr std::chrono::milliseconds kWaitPollInterval{1};
+
+    bool TryRunTask(size_t worker_index, bool may_steal);
+    size_t GetCurrentWorker() const;
+    void WorkerLoop(size_t worker_index);
+
+private:
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> queued_tasks_ = 0;
+    std::atomic<size_t> next_queue_ = 0;
+    std::mutex sleep_mutex_;
+    std::condition_variable has_task_;
+    bool stopping_ = false;
+};
@@ -0,0 +1,112 @@
+#include "buffer_writer.h"
+
+#include <cstring>
+#include <stdexcept>
+
+BufferWriter::BufferWriter(std::span<std::byte> buffer) : buffer_(buffer) {
+}
+
+BufferWriter::BufferWriter(std::vector<std::byte>& buffer) : vector_(&buffer), start_(buffer.size()) {
+}
+
+void BufferWriter::OpenFile(const std::string& filename) {
+    Flush();
+    files_.push_back({filename, size_, 0});
+}
+
+void BufferWriter::CloseFile() {
+    Flush();
+
+    if (!files_.empty()) {
+        files_.back().size = size_ - files_.back().offset;
+    }
+}
+
+void BufferWriter::WriteByte(unsigned char byte) {
+    if (bit_count_ != 0) {
+        WriteBits(byte, 8);
+        return;
+    }
+
+    PutBytes({&byte, 1});
+}
+
+void BufferWriter::WriteBytes(std::span<const unsigned char> bytes) {
+    if (bit_count_ != 0) {
+        for (unsigned char byte : bytes) {
+            WriteBits(byte, 8);
+        }
+
+        return;
+    }
+
+    PutBytes(bytes);
+}
+
+void BufferWriter::WriteBit(bool bit) {
+    WriteBits(bit, 1);
+}
+
+void BufferWriter::WriteBits(uint64_t bits, size_t count) {
+    // bit_buffer_ holds less than 8 pending bits between calls, so 56 more always fit.
+    if (count > 56) {
+        WriteBits(bits >> 32, count - 32);
+        count = 32;
+    }
+
+    bit_buffer_ = (bit_buffer_ << count) | (bits & ((uint64_t(1) << count) - 1));
+    bit_count_ += count;
+
+    // All the finished bytes go to the buffer at once, the unfinished one stays in bit_buffer_.
+    unsigned char bytes[8];
+    size_t bytes_count = 0;
+
+    while (bit_count_ >= 8) {
+        bit_count_ -= 8;
+        bytes[bytes_count++] = bit_buffer_ >> bit_count_;
+    }
+
+    PutBytes({bytes, bytes_count});
+}
+
+void BufferWriter::Flush() {
+    if (bit_count_ != 0) {
+        unsigned char byte = bit_buffer_ << (8 - bit_count_);
+        bit_count_ = 0;
+        PutBytes({&byte, 1});
+    }
+
+    bit_buffer_ = 0;
+}
+
+std::span<std::byte> BufferWriter::GetWritten() const {
+    if (vector_ != nullptr) {
+        return std::span(*vector_).subspan(start_, size_);
+    }
+
+    return buffer_.first(size_);
+}
+
+const std::vector<BufferWriter::FileRange>& BufferWriter::GetFiles() const {
+    return files_;
+}
+
+void BufferWriter::PutBytes(std::span<const unsigned char> bytes) {
+    if (bytes.empty()) {
+        return;
+    }
+
+    auto* begin = reinterpret_cast<const std::byte*>(bytes.data());
+
+    if (vector_ != nullptr) {
+        vector_->insert(vector_->end(), begin, begin + bytes.size());
+    } else {
+        if (bytes.size() > buffer_.size() - size_) {
+            throw std::length_error("WRITER: Output buffer is too small");
+        }
+
+        std::memcpy(buffer_.data() + size_, begin, bytes.size());
+    }
+
+    size_ += bytes.size();
+}
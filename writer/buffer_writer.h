@@ -0,0 +1,47 @@
+#pragma once
+#include "writer_interface.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Writes into a buffer of the caller: a fixed one, which throws std::length_error when it is full, or a vector,
+// which grows at its end. Remembers where every opened file starts, so files written one after another can be
+// found in the buffer.
+class BufferWriter final : public WriterInterface {
+public:
+    struct FileRange {
+        std::string file_name;
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    explicit BufferWriter(std::span<std::byte> buffer);
+    explicit BufferWriter(std::vector<std::byte>& buffer);
+    BufferWriter(const BufferWriter& o) = delete;
+    BufferWriter& operator=(const BufferWriter& o) = delete;
+
+    void OpenFile(const std::string& filename) override;
+    void CloseFile() override;
+    void WriteByte(unsigned char byte) override;
+    void WriteBytes(std::span<const unsigned char> bytes) override;
+    void WriteBit(bool bit) override;
+    void WriteBits(uint64_t bits, size_t count) override;
+    void Flush() override;
+
+    // Bytes written so far, in the vector they start at its size at construction.
+    std::span<std::byte> GetWritten() const;
+    const std::vector<FileRange>& GetFiles() const;
+
+private:
+    void PutBytes(std::span<const unsigned char> bytes);
+
+private:
+    std::vector<std::byte>* vector_ = nullptr;
+    std::span<std::byte> buffer_;
+    size_t start_ = 0;
+    size_t size_ = 0;
+    std::vector<FileRange> files_;
+    uint64_t bit_buffer_ = 0;
+    size_t bit_count_ = 0;
+};
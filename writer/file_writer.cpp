@@ -1,13 +1,22 @@
 #include "file_writer.h"
 
-FileWriter::FileWriter(std::string directory) : directory_(std::move(directory)) {
+#include <algorithm>
+
+FileWriter::FileWriter(std::string directory, size_t buffer_size)
+    : directory_(std::move(directory)), buffer_(std::max(buffer_size, size_t(4))) {
     if(!directory_.empty()) {
         directory_.push_back('/');
     }
 }
 
+FileWriter::~FileWriter() {
+    if(file_.is_open()) {
+        CloseFile();
+    }
+}
+
 void FileWriter::OpenFile(const std::string& filename) {
-    file_.open(directory_ + filename);
+    file_.open(directory_ + filename, std::ios::binary);
 
     if(!file_) {
         throw std::runtime_error("WRITER::OPEN_FILE: Can't open file: " + directory_ + filename);
@@ -15,7 +24,41 @@ void FileWriter::OpenFile(const std::string& filename) {
 }
 
 void FileWriter::WriteByte(unsigned char byte) {
-    file_.write(reinterpret_cast<char*>(&byte), 1);
+    if(bit_count_ != 0) {
+        WriteBits(byte, 8);
+        return;
+    }
+
+    PutByte(byte);
+}
+
+void FileWriter::WriteBytes(std::span<const unsigned char> bytes) {
+    if(bit_count_ != 0) {
+        size_t i = 0;
+
+        for(; i + 4 <= bytes.size(); i += 4) {
+            WriteBits((uint64_t(bytes[i]) << 24) | (bytes[i + 1] << 16) | (bytes[i + 2] << 8) | bytes[i + 3], 32);
+        }
+
+        for(; i < bytes.size(); ++i) {
+            WriteBits(bytes[i], 8);
+        }
+
+        return;
+    }
+
+    if(bytes.size() >= buffer_.size()) {
+        FlushBuffer();
+        file_.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+        return;
+    }
+
+    if(buffer_pos_ + bytes.size() > buffer_.size()) {
+        FlushBuffer();
+    }
+
+    std::copy(bytes.begin(), bytes.end(), buffer_.begin() + buffer_pos_);
+    buffer_pos_ += bytes.size();
 }
 
 void FileWriter::CloseFile() {
@@ -24,21 +67,59 @@ void FileWriter::CloseFile() {
 }
 
 void FileWriter::WriteBit(bool bit) {
-    if(bit) {
-        buffer_byte_ |= (1 << (7 - bit_pos_));
+    WriteBits(bit, 1);
+}
+
+void FileWriter::WriteBits(uint64_t bits, size_t count) {
+    // bit_buffer_ never holds more than 31 pending bits, so 32 more always fit.
+    if(count > 32) {
+        WriteBits(bits >> 32, count - 32);
+        count = 32;
     }
 
-    ++bit_pos_;
+    bit_buffer_ = (bit_buffer_ << count) | (bits & ((uint64_t(1) << count) - 1));
+    bit_count_ += count;
+
+    if(bit_count_ >= 32) {
+        bit_count_ -= 32;
 
-    if(bit_pos_ == 8) {
-        Flush();
+        if(buffer_pos_ + 4 > buffer_.size()) {
+            FlushBuffer();
+        }
+
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 24);
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 16);
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 8);
+        buffer_[buffer_pos_++] = bit_buffer_ >> bit_count_;
     }
 }
 
 void FileWriter::Flush() {
-    if(bit_pos_ != 0) {
-        WriteByte(buffer_byte_);
-        buffer_byte_ = 0;
-        bit_pos_ = 0;
+    while(bit_count_ >= 8) {
+        bit_count_ -= 8;
+        PutByte(bit_buffer_ >> bit_count_);
+    }
+
+    if(bit_count_ != 0) {
+        PutByte(bit_buffer_ << (8 - bit_count_));
+        bit_count_ = 0;
+    }
+
+    bit_buffer_ = 0;
+    FlushBuffer();
+}
+
+void FileWriter::PutByte(unsigned char byte) {
+    if(buffer_pos_ == buffer_.size()) {
+        FlushBuffer();
+    }
+
+    buffer_[buffer_pos_++] = byte;
+}
+
+void FileWriter::FlushBuffer() {
+    if(buffer_pos_ != 0) {
+        file_.write(reinterpret_cast<const char*>(buffer_.data()), std::streamsize(buffer_pos_));
+        buffer_pos_ = 0;
     }
-}
\ No newline at end of file
+}
@@ -3,24 +3,36 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 
-class FileWriter : public WriterInterface {
+class FileWriter final : public WriterInterface {
 public:
-    explicit FileWriter(std::string directory);
+    static const size_t kDefaultBufferSize = 1 << 20;
+
+    explicit FileWriter(std::string directory, size_t buffer_size = kDefaultBufferSize);
     FileWriter(const FileWriter& o) = delete;
     FileWriter& operator=(const FileWriter& o) = delete;
     FileWriter(FileWriter&& o) = default;
     FileWriter& operator=(FileWriter&& o) = default;
+    ~FileWriter() override;
 
     void OpenFile(const std::string& filename) override;
     void CloseFile() override;
     void WriteByte(unsigned char byte) override;
+    void WriteBytes(std::span<const unsigned char> bytes) override;
     void WriteBit(bool bit) override;
+    void WriteBits(uint64_t bits, size_t count) override;
     void Flush() override;
 
+private:
+    void PutByte(unsigned char byte);
+    void FlushBuffer();
+
 private:
     std::string directory_;
     std::ofstream file_;
-    unsigned char buffer_byte_ = 0;
-    char bit_pos_ = 0;
-};
\ No newline at end of file
+    std::vector<unsigned char> buffer_;
+    size_t buffer_pos_ = 0;
+    uint64_t bit_buffer_ = 0;
+    size_t bit_count_ = 0;
+};
@@ -0,0 +1,55 @@
+#include "memory_writer.h"
+
+void MemoryWriter::OpenFile(const std::string&) {
+}
+
+void MemoryWriter::CloseFile() {
+    Flush();
+}
+
+void MemoryWriter::WriteByte(unsigned char byte) {
+    if(bit_count_ != 0) {
+        WriteBits(byte, 8);
+        return;
+    }
+
+    data_.push_back(byte);
+}
+
+void MemoryWriter::WriteBytes(std::span<const unsigned char> bytes) {
+    if(bit_count_ != 0) {
+        for(unsigned char byte : bytes) {
+            WriteBits(byte, 8);
+        }
+
+        return;
+    }
+
+    data_.insert(data_.end(), bytes.begin(), bytes.end());
+}
+
+void MemoryWriter::WriteBit(bool bit) {
+    WriteBits(bit, 1);
+}
+
+void MemoryWriter::Flush() {
+    if(bit_count_ != 0) {
+        data_.push_back(bit_buffer_ << (8 - bit_count_));
+        bit_count_ = 0;
+    }
+
+    bit_buffer_ = 0;
+}
+
+const std::vector<unsigned char>& MemoryWriter::GetData() const {
+    return data_;
+}
+
+void MemoryWriter::MoveTo(WriterInterface& writer) {
+    writer.WriteBytes(data_);
+    writer.WriteBits(bit_buffer_, bit_count_);
+
+    data_.clear();
+    bit_buffer_ = 0;
+    bit_count_ = 0;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "writer_interface.h"
+
+#include <vector>
+
+// Collects written bits and bytes in memory, so they can be moved to another writer later. Chunks are encoded
+// into it symbol by symbol, so WriteBits is defined here to be inlined into the encoding loops.
+class MemoryWriter final : public WriterInterface {
+public:
+    MemoryWriter() = default;
+    MemoryWriter(const MemoryWriter& o) = delete;
+    MemoryWriter& operator=(const MemoryWriter& o) = delete;
+    MemoryWriter(MemoryWriter&& o) = default;
+    MemoryWriter& operator=(MemoryWriter&& o) = default;
+
+    void OpenFile(const std::string& filename) override;
+    void CloseFile() override;
+    void WriteByte(unsigned char byte) override;
+    void WriteBytes(std::span<const unsigned char> bytes) override;
+    void WriteBit(bool bit) override;
+    void WriteBits(uint64_t bits, size_t count) override;
+    void Flush() override;
+
+    const std::vector<unsigned char>& GetData() const;
+    // Appends everything written so far to writer, unfinished byte included bit by bit, and clears this writer.
+    void MoveTo(WriterInterface& writer);
+
+private:
+    std::vector<unsigned char> data_;
+    uint64_t bit_buffer_ = 0;
+    size_t bit_count_ = 0;
+};
+
+inline void MemoryWriter::WriteBits(uint64_t bits, size_t count) {
+    // bit_buffer_ holds less than 8 pending bits between calls, so 56 more always fit.
+    if(count > 56) {
+        WriteBits(bits >> 32, count - 32);
+        count = 32;
+    }
+
+    bit_buffer_ = (bit_buffer_ << count) | (bits & ((uint64_t(1) << count) - 1));
+    bit_count_ += count;
+
+    while(bit_count_ >= 8) {
+        bit_count_ -= 8;
+        data_.push_back(bit_buffer_ >> bit_count_);
+    }
+}
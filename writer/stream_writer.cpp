@@ -0,0 +1,142 @@
+#include "stream_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+StreamWriter::StreamWriter(int fd, size_t buffer_size) : fd_(fd), buffer_(std::max(buffer_size, size_t(4))) {
+}
+
+StreamWriter::~StreamWriter() {
+    if (is_file_open_) {
+        try {
+            CloseFile();
+        } catch (const std::exception&) {
+        }
+    }
+}
+
+void StreamWriter::OpenFile(const std::string& filename) {
+    if (was_file_opened_) {
+        throw std::runtime_error("WRITER::OPEN_FILE: Stream can hold only one file, can't open: " + filename);
+    }
+
+    is_file_open_ = true;
+    was_file_opened_ = true;
+}
+
+void StreamWriter::CloseFile() {
+    is_file_open_ = false;
+    Flush();
+}
+
+void StreamWriter::WriteByte(unsigned char byte) {
+    if (bit_count_ != 0) {
+        WriteBits(byte, 8);
+        return;
+    }
+
+    PutByte(byte);
+}
+
+void StreamWriter::WriteBytes(std::span<const unsigned char> bytes) {
+    if (bit_count_ != 0) {
+        size_t i = 0;
+
+        for (; i + 4 <= bytes.size(); i += 4) {
+            WriteBits((uint64_t(bytes[i]) << 24) | (bytes[i + 1] << 16) | (bytes[i + 2] << 8) | bytes[i + 3], 32);
+        }
+
+        for (; i < bytes.size(); ++i) {
+            WriteBits(bytes[i], 8);
+        }
+
+        return;
+    }
+
+    if (bytes.size() >= buffer_.size()) {
+        FlushBuffer();
+        WriteToStream(bytes);
+        return;
+    }
+
+    if (buffer_pos_ + bytes.size() > buffer_.size()) {
+        FlushBuffer();
+    }
+
+    std::copy(bytes.begin(), bytes.end(), buffer_.begin() + buffer_pos_);
+    buffer_pos_ += bytes.size();
+}
+
+void StreamWriter::WriteBit(bool bit) {
+    WriteBits(bit, 1);
+}
+
+void StreamWriter::WriteBits(uint64_t bits, size_t count) {
+    if (count > 32) {
+        WriteBits(bits >> 32, count - 32);
+        count = 32;
+    }
+
+    bit_buffer_ = (bit_buffer_ << count) | (bits & ((uint64_t(1) << count) - 1));
+    bit_count_ += count;
+
+    if (bit_count_ >= 32) {
+        bit_count_ -= 32;
+
+        if (buffer_pos_ + 4 > buffer_.size()) {
+            FlushBuffer();
+        }
+
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 24);
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 16);
+        buffer_[buffer_pos_++] = bit_buffer_ >> (bit_count_ + 8);
+        buffer_[buffer_pos_++] = bit_buffer_ >> bit_count_;
+    }
+}
+
+void StreamWriter::Flush() {
+    while (bit_count_ >= 8) {
+        bit_count_ -= 8;
+        PutByte(bit_buffer_ >> bit_count_);
+    }
+
+    if (bit_count_ != 0) {
+        PutByte(bit_buffer_ << (8 - bit_count_));
+        bit_count_ = 0;
+    }
+
+    bit_buffer_ = 0;
+    FlushBuffer();
+}
+
+void StreamWriter::PutByte(unsigned char byte) {
+    if (buffer_pos_ == buffer_.size()) {
+        FlushBuffer();
+    }
+
+    buffer_[buffer_pos_++] = byte;
+}
+
+void StreamWriter::FlushBuffer() {
+    if (buffer_pos_ != 0) {
+        WriteToStream({buffer_.data(), buffer_pos_});
+        buffer_pos_ = 0;
+    }
+}
+
+void StreamWriter::WriteToStream(std::span<const unsigned char> bytes) {
+    while (!bytes.empty()) {
+        ssize_t bytes_written = write(fd_, bytes.data(), bytes.size());
+
+        if (bytes_written == -1 && errno == EINTR) {
+            continue;
+        }
+
+        if (bytes_written == -1) {
+            throw std::runtime_error("WRITER: Can't write to stream");
+        }
+
+        bytes = bytes.subspan(bytes_written);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "writer_interface.h"
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// Writes a single file into a stream (standard output by default) through a buffer of a fixed size.
+class StreamWriter final : public WriterInterface {
+public:
+    static const size_t kDefaultBufferSize = 1 << 20;
+
+    explicit StreamWriter(int fd = STDOUT_FILENO, size_t buffer_size = kDefaultBufferSize);
+    StreamWriter(const StreamWriter& o) = delete;
+    StreamWriter& operator=(const StreamWriter& o) = delete;
+    StreamWriter(StreamWriter&& o) = default;
+    StreamWriter& operator=(StreamWriter&& o) = default;
+    ~StreamWriter() override;
+
+    // File name is ignored, opening a second file throws since the stream can't separate files.
+    void OpenFile(const std::string& filename) override;
+    void CloseFile() override;
+    void WriteByte(unsigned char byte) override;
+    void WriteBytes(std::span<const unsigned char> bytes) override;
+    void WriteBit(bool bit) override;
+    void WriteBits(uint64_t bits, size_t count) override;
+    void Flush() override;
+
+private:
+    void PutByte(unsigned char byte);
+    void FlushBuffer();
+    void WriteToStream(std::span<const unsigned char> bytes);
+
+private:
+    int fd_ = STDOUT_FILENO;
+    bool is_file_open_ = false;
+    bool was_file_opened_ = false;
+    std::vector<unsigned char> buffer_;
+    size_t buffer_pos_ = 0;
+    uint64_t bit_buffer_ = 0;
+    size_t bit_count_ = 0;
+};
@@ -1,10 +1,15 @@
+#include "writer/buffer_writer.h"
 #include "writer/file_writer.h"
+#include "writer/memory_writer.h"
+#include "writer/stream_writer.h"
 #include <gtest/gtest.h>
 
 #include <vector>
 
 #include "reader/file_reader.h"
 
+#include <fcntl.h>
+
 void ByteWritingTest(const std::vector<unsigned char>& data) {
     const std::string test_dir = "mock/";
     const std::string test_name = "test.bin";
@@ -49,11 +54,173 @@ void BitWritingTest(const std::vector<unsigned char>& data) {
     }
 }
 
+void MultiBitWritingTest(const std::vector<unsigned char>& data) {
+    const std::string test_dir = "mock/";
+    const std::string test_name = "test.bin";
+
+    for (size_t buffer_size : {4, 7, 1 << 20}) {
+        FileWriter writer(test_dir, buffer_size);
+
+        writer.OpenFile(test_name);
+
+        uint64_t bits = 0;
+        size_t bit_count = 0;
+        size_t next_count = 1;
+
+        for (auto byte : data) {
+            for (size_t i = 0; i < 8; ++i) {
+                bits = (bits << 1) | ((byte >> (7 - i)) & 1);
+                ++bit_count;
+
+                if (bit_count == next_count) {
+                    writer.WriteBits(bits, bit_count);
+                    next_count = next_count % 64 + 13;
+                    bits = 0;
+                    bit_count = 0;
+                }
+            }
+        }
+
+        writer.WriteBits(bits, bit_count);
+        writer.CloseFile();
+
+        FileReader reader(test_dir + test_name);
+
+        for (auto byte : data) {
+            ASSERT_EQ(reader.ReadNextByte(), byte);
+        }
+
+        ASSERT_FALSE(reader.HasNextByte());
+    }
+}
+
+void MixedWritingTest(const std::vector<unsigned char>& data) {
+    const std::string test_dir = "mock/";
+    const std::string test_name = "test.bin";
+
+    FileWriter writer(test_dir, 5);
+
+    writer.OpenFile(test_name);
+    writer.WriteBytes(std::span(data).first(3));
+    writer.WriteBits(data[3] >> 4, 4);
+    writer.WriteBits(data[3] & 0xF, 4);
+    writer.WriteBytes(std::span(data).subspan(4));
+    writer.CloseFile();
+
+    FileReader reader(test_dir + test_name);
+
+    for (auto byte : data) {
+        ASSERT_EQ(reader.ReadNextByte(), byte);
+    }
+
+    ASSERT_FALSE(reader.HasNextByte());
+}
+
+void MemoryWritingTest(const std::vector<unsigned char>& data) {
+    const std::string test_dir = "mock/";
+    const std::string test_name = "test.bin";
+
+    MemoryWriter memory_writer;
+
+    memory_writer.WriteBits(data[0], 5);
+    memory_writer.WriteBytes(std::span(data).subspan(1, data.size() - 2));
+
+    FileWriter writer(test_dir);
+
+    writer.OpenFile(test_name);
+    writer.WriteBits(data[0] >> 5, 3);
+    memory_writer.MoveTo(writer);
+    writer.WriteByte(data.back());
+    writer.CloseFile();
+
+    ASSERT_TRUE(memory_writer.GetData().empty());
+
+    FileReader reader(test_dir + test_name);
+
+    for (auto byte : data) {
+        ASSERT_EQ(reader.ReadNextByte(), byte);
+    }
+
+    ASSERT_FALSE(reader.HasNextByte());
+}
+
+void StreamWritingTest(const std::vector<unsigned char>& data) {
+    const std::string test_path = "mock/test.bin";
+
+    for (size_t buffer_size : {4, 7, 1 << 20}) {
+        int fd = open(test_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_NE(fd, -1);
+
+        {
+            StreamWriter writer(fd, buffer_size);
+
+            writer.OpenFile("ignored");
+            writer.WriteBytes(std::span(data).first(3));
+            writer.WriteBits(data[3] >> 4, 4);
+            writer.WriteBits(((data[3] & 0xF) << 8) | data[4], 12);
+            writer.WriteBytes(std::span(data).subspan(5));
+            writer.CloseFile();
+
+            ASSERT_THROW(writer.OpenFile("second"), std::runtime_error);
+        }
+
+        close(fd);
+
+        FileReader reader(test_path);
+
+        for (auto byte : data) {
+            ASSERT_EQ(reader.ReadNextByte(), byte);
+        }
+
+        ASSERT_FALSE(reader.HasNextByte());
+    }
+}
+
+void BufferWritingTest(const std::vector<unsigned char>& data) {
+    auto write = [&data](BufferWriter& writer) {
+        writer.OpenFile("first");
+        writer.WriteBits(data[0] >> 4, 4);
+        writer.WriteBits(((data[0] & 0xF) << 8) | data[1], 12);
+        writer.CloseFile();
+        writer.OpenFile("second");
+        writer.WriteBytes(std::span(data).subspan(2));
+        writer.CloseFile();
+    };
+
+    auto check = [&data](const BufferWriter& writer) {
+        ASSERT_EQ(writer.GetWritten().size(), data.size());
+        ASSERT_TRUE(std::equal(data.begin(), data.end(), reinterpret_cast<unsigned char*>(writer.GetWritten().data())));
+        ASSERT_EQ(writer.GetFiles().size(), 2);
+        ASSERT_EQ(writer.GetFiles()[1].file_name, "second");
+        ASSERT_EQ(writer.GetFiles()[1].offset, 2);
+        ASSERT_EQ(writer.GetFiles()[1].size, data.size() - 2);
+    };
+
+    std::vector<std::byte> growing(3);
+    BufferWriter growing_writer(growing);
+    write(growing_writer);
+    check(growing_writer);
+    ASSERT_EQ(growing.size(), data.size() + 3);
+
+    std::vector<std::byte> fixed(data.size());
+    BufferWriter fixed_writer{std::span(fixed)};
+    write(fixed_writer);
+    check(fixed_writer);
+
+    BufferWriter small_writer{std::span(fixed).first(data.size() - 1)};
+    ASSERT_THROW(write(small_writer), std::length_error);
+}
+
 TEST(FileReader, WriteBinaryFile1) {
     const std::vector<unsigned char> test_data = {0xAA, 0xAA, 0xAA, 0xAA, 0xBB, 0xBB,
                                                   0xBB, 0xBB, 0xCC, 0xCC, 0xCC, 0xCC};
     ByteWritingTest(test_data);
     BitWritingTest(test_data);
+    MultiBitWritingTest(test_data);
+    MixedWritingTest(test_data);
+    MemoryWritingTest(test_data);
+    StreamWritingTest(test_data);
+    BufferWritingTest(test_data);
 }
 
 TEST(FileReader, WriteBinaryFile2) {
@@ -61,6 +228,11 @@ TEST(FileReader, WriteBinaryFile2) {
                                                   0xF6, 0xBC, 0xDD, 0x30, 0x00, 0x40, 0xFF};
     ByteWritingTest(test_data);
     BitWritingTest(test_data);
+    MultiBitWritingTest(test_data);
+    MixedWritingTest(test_data);
+    MemoryWritingTest(test_data);
+    StreamWritingTest(test_data);
+    BufferWritingTest(test_data);
 }
 
 int main(int argc, char** argv) {
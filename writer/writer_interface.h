@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <span>
 #include <string>
 
 class WriterInterface {
@@ -8,6 +10,9 @@ public:
     virtual void OpenFile(const std::string& file_name) = 0;
     virtual void CloseFile() = 0;
     virtual void WriteByte(unsigned char byte) = 0;
+    virtual void WriteBytes(std::span<const unsigned char> bytes) = 0;
     virtual void WriteBit(bool bit) = 0;
+    // Writes count (at most 64) lowest bits of bits, starting from the most significant one.
+    virtual void WriteBits(uint64_t bits, size_t count) = 0;
     virtual void Flush() = 0;
-};
\ No newline at end of file
+};